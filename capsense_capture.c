@@ -0,0 +1,276 @@
+/******************************************************************************
+* File Name: capsense_capture.c
+*
+* Description: This is the source code for the optional touch trace capture.
+*              The button status before and after FSS is appended to a byte
+*              ring, delta encoded, on every frame where it changes.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "capsense_capture.h"
+
+#if (CAPSENSE_CAPTURE_ENABLE != 0u)
+
+#include <stdbool.h>
+#include "capsense_fss_algorithm.h"
+#include "cy_pdl.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Bytes of a bitmap that can hold a button sensor */
+#define CAPTURE_BITMAP_BYTES           ((FSS_SENSOR_COUNT + 7u) / 8u)
+
+#define CAPTURE_VARINT_MAX             (5u)
+#define CAPTURE_RECORD_MAX             (CAPTURE_VARINT_MAX + (2u * (CAPTURE_VARINT_MAX + CAPTURE_BITMAP_BYTES)))
+
+/* Frames since the last record, saturating so that the header fits 32 bits */
+#define CAPTURE_DELTA_MAX              (0x3FFFFFFFu)
+
+#define CAPTURE_OVERFLOW_MAX           (0xFFFFu)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static capsense_capture_ring_t *captureRing;
+static volatile uint16_t *captureTail;
+
+/* Last tail read from the consumer that fits the ring */
+static uint16_t captureTailSeen;
+
+/* Button status of the last record written, and whether the next record
+ * must be a key record because records were dropped since
+ */
+static fss_bitmap_t lastRaw;
+static fss_bitmap_t lastSuppressed;
+static bool captureResync;
+
+static uint32_t framesSinceRecord;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static uint8_t capture_varint(uint8_t *record, uint8_t length, uint32_t value);
+static uint8_t capture_bitmap(uint8_t *record, uint8_t length, const fss_bitmap_t *bitmap,
+                              const fss_bitmap_t *base);
+
+/*******************************************************************************
+* Function Name: capsense_capture_init
+********************************************************************************
+* Summary:
+*  This function empties the ring. Call it after capsense_fss_init().
+*
+* Parameters:
+*  ring: the ring to fill
+*  tail: the read index of the consumer, which may be written by the host
+*
+*******************************************************************************/
+void capsense_capture_init(capsense_capture_ring_t *ring, volatile uint16_t *tail)
+{
+    captureRing = ring;
+    captureTail = tail;
+
+    captureRing->head = 0;
+    captureRing->overflow = 0;
+    *captureTail = 0;
+    captureTailSeen = 0;
+
+    for (uint32_t word = 0; word < FSS_WORD_COUNT; word++)
+    {
+        lastRaw.word[word] = 0;
+        lastSuppressed.word[word] = 0;
+    }
+    captureResync = false;
+    framesSinceRecord = 0;
+}
+
+
+/*******************************************************************************
+* Function Name: capsense_capture_update
+********************************************************************************
+* Summary:
+*  This function appends a record if the button status before or after FSS
+*  changed since the last record. A frame without change only counts the
+*  frame, so idle frames take no space. A record that does not fit in the
+*  ring is dropped and counted in overflow; a key record is then tried
+*  every frame until one fits, so that the status after a dropped release
+*  is not lost on an idle panel. Call it once per frame after
+*  capsense_fss().
+*
+*******************************************************************************/
+void capsense_capture_update(void)
+{
+    static const fss_bitmap_t empty;
+    const fss_bitmap_t *raw = capsense_fss_get_raw_status();
+    const fss_bitmap_t *status = capsense_fss_get_status();
+    const fss_bitmap_t *baseRaw = captureResync ? &empty : &lastRaw;
+    const fss_bitmap_t *baseSuppressed = captureResync ? &empty : &lastSuppressed;
+    fss_bitmap_t suppressed;
+    uint8_t record[CAPTURE_RECORD_MAX];
+    uint32_t header;
+    uint16_t head;
+    uint16_t tail;
+    uint8_t length;
+    bool changed = false;
+    bool suppressedChanged = false;
+
+    if (framesSinceRecord < CAPTURE_DELTA_MAX)
+    {
+        framesSinceRecord++;
+    }
+
+    for (uint32_t word = 0; word < FSS_WORD_COUNT; word++)
+    {
+        suppressed.word[word] = raw->word[word] & ~status->word[word];
+        changed = changed || (raw->word[word] != lastRaw.word[word]) ||
+                  (suppressed.word[word] != lastSuppressed.word[word]);
+        suppressedChanged = suppressedChanged || (suppressed.word[word] != baseSuppressed->word[word]);
+    }
+
+    if (!changed && !captureResync)
+    {
+        return;
+    }
+
+    header = (framesSinceRecord << CAPSENSE_CAPTURE_DELTA_SHIFT) |
+             (captureResync ? CAPSENSE_CAPTURE_KEY : 0u) | (suppressedChanged ? CAPSENSE_CAPTURE_SUPPRESSED : 0u);
+    length = capture_varint(record, 0, header);
+    length = capture_bitmap(record, length, raw, baseRaw);
+    if (suppressedChanged)
+    {
+        length = capture_bitmap(record, length, &suppressed, baseSuppressed);
+    }
+
+    /* The host writes the tail a byte at a time. A tail read halfway through
+     * lies behind the new one or outside the ring, so it is used only if it
+     * fits, which can only underestimate the free space.
+     */
+    head = captureRing->head;
+    tail = *captureTail;
+    if ((uint16_t)(head - tail) <= CAPSENSE_CAPTURE_RING_SIZE)
+    {
+        captureTailSeen = tail;
+    }
+
+    if ((CAPSENSE_CAPTURE_RING_SIZE - (uint16_t)(head - captureTailSeen)) < length)
+    {
+        if (captureRing->overflow < CAPTURE_OVERFLOW_MAX)
+        {
+            captureRing->overflow++;
+        }
+        captureResync = true;
+        return;
+    }
+
+    for (uint8_t index = 0; index < length; index++)
+    {
+        captureRing->data[(uint16_t)(head + index) & CAPSENSE_CAPTURE_RING_MASK] = record[index];
+    }
+
+    /* Publishing the head only after the record is written */
+    __DMB();
+    captureRing->head = (uint16_t)(head + length);
+
+    lastRaw = *raw;
+    lastSuppressed = suppressed;
+    captureResync = false;
+    framesSinceRecord = 0;
+}
+
+
+/*******************************************************************************
+* Function Name: capture_varint
+********************************************************************************
+* Summary:
+*  Appends value to the record as an unsigned LEB128 varint and returns the
+*  new record length.
+*
+*******************************************************************************/
+static uint8_t capture_varint(uint8_t *record, uint8_t length, uint32_t value)
+{
+    while (value >= 0x80u)
+    {
+        record[length++] = (uint8_t)(value | 0x80u);
+        value >>= 7u;
+    }
+    record[length++] = (uint8_t)value;
+
+    return length;
+}
+
+
+/*******************************************************************************
+* Function Name: capture_bitmap
+********************************************************************************
+* Summary:
+*  Appends the bytes of bitmap that differ from base, XORed with it, after a
+*  mask of their positions, and returns the new record length.
+*
+*******************************************************************************/
+static uint8_t capture_bitmap(uint8_t *record, uint8_t length, const fss_bitmap_t *bitmap,
+                              const fss_bitmap_t *base)
+{
+    uint8_t changes[CAPTURE_BITMAP_BYTES];
+    uint32_t mask = 0;
+    uint8_t count = 0;
+
+    for (uint8_t byte = 0; byte < CAPTURE_BITMAP_BYTES; byte++)
+    {
+        uint8_t change = (uint8_t)((bitmap->word[byte / 4u] ^ base->word[byte / 4u]) >> ((byte % 4u) * 8u));
+
+        if (0u != change)
+        {
+            mask |= (uint32_t)1u << byte;
+            changes[count++] = change;
+        }
+    }
+
+    length = capture_varint(record, length, mask);
+    for (uint8_t index = 0; index < count; index++)
+    {
+        record[length++] = changes[index];
+    }
+
+    return length;
+}
+
+#endif /* CAPSENSE_CAPTURE_ENABLE */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,115 @@
+/******************************************************************************
+* File Name: capsense_capture.h
+*
+* Description: This file contains the record format and the function
+*              prototypes of the optional touch trace capture
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CAPSENSE_CAPTURE_H
+#define CAPSENSE_CAPTURE_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Set to 1 to record the button status before and after FSS of every frame
+ * where it changes in a byte ring of the FSS control block, drained by the
+ * host over EZI2C. Refer README.md.
+ */
+#ifndef CAPSENSE_CAPTURE_ENABLE
+#define CAPSENSE_CAPTURE_ENABLE        (0u)
+#endif
+
+/* Size of the ring in bytes; a power of two, up to 32768 */
+#ifndef CAPSENSE_CAPTURE_RING_SIZE
+#define CAPSENSE_CAPTURE_RING_SIZE     (512u)
+#endif
+
+#if ((CAPSENSE_CAPTURE_RING_SIZE & (CAPSENSE_CAPTURE_RING_SIZE - 1u)) != 0u) || \
+    (CAPSENSE_CAPTURE_RING_SIZE > 32768u) || (CAPSENSE_CAPTURE_RING_SIZE < 128u)
+#error "CAPSENSE_CAPTURE_RING_SIZE must be a power of two between 128 and 32768"
+#endif
+
+#define CAPSENSE_CAPTURE_RING_MASK     (CAPSENSE_CAPTURE_RING_SIZE - 1u)
+
+/* Record layout, all numbers being unsigned LEB128 varints (7 bits per
+ * byte, lowest first, bit 7 set on all bytes but the last):
+ * - header: (frames since the last record << 2) | CAPSENSE_CAPTURE_KEY |
+ *   CAPSENSE_CAPTURE_SUPPRESSED
+ * - raw status: a mask with bit N set if byte N of the bitmap changed since
+ *   the last record, then the changed bytes XORed with their old value
+ * - with CAPSENSE_CAPTURE_SUPPRESSED: the touches suppressed by FSS (raw and
+ *   not after FSS), in the same form
+ * Byte N of a bitmap holds sensors 8N to 8N + 7. A key record, written after
+ * records were dropped on a full ring, is XORed with an empty bitmap instead
+ * of the last record.
+ */
+#define CAPSENSE_CAPTURE_SUPPRESSED    (0x01u)
+#define CAPSENSE_CAPTURE_KEY           (0x02u)
+#define CAPSENSE_CAPTURE_DELTA_SHIFT   (2u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Single producer, single consumer byte ring. head and the tail of the
+ * consumer run freely and are reduced with CAPSENSE_CAPTURE_RING_MASK; the
+ * ring holds head - tail bytes of whole records. The producer only writes
+ * head and the data, the consumer only its tail.
+ */
+typedef struct
+{
+    volatile uint16_t head;                     /* Written by the producer */
+    volatile uint16_t overflow;                 /* Records dropped on a full ring, saturating */
+    uint8_t data[CAPSENSE_CAPTURE_RING_SIZE];
+} capsense_capture_ring_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+#if (CAPSENSE_CAPTURE_ENABLE != 0u)
+void capsense_capture_init(capsense_capture_ring_t *ring, volatile uint16_t *tail);
+void capsense_capture_update(void);
+#endif
+
+#endif /* CAPSENSE_CAPTURE_H */
+
+
+/* [] END OF FILE */
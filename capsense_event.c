@@ -0,0 +1,249 @@
+/******************************************************************************
+* File Name: capsense_event.c
+*
+* Description: This is the source code for the touch event ring. Every frame,
+*              the changes of the FSS button status are queued as events, which
+*              the application or the host over EZI2C can drain instead of polling
+*              the sensor status.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "capsense_event.h"
+#include "capsense_fss_algorithm.h"
+#include "capsense_idle.h"
+#include "fss_bitops.h"
+#include "cy_pdl.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Time stamp of the events. By default, the elapsed SysTick ticks modulo
+ * 2^24, SysTick running freely from the CPU clock. SysTick stops in Deep
+ * Sleep, so with the idle mode the nominal time spent in Deep Sleep is
+ * added. Define it to read another timer.
+ */
+#ifndef CAPSENSE_EVENT_TIMESTAMP
+#if (CAPSENSE_IDLE_ENABLE != 0u)
+#define CAPSENSE_EVENT_TIMESTAMP()     (((SysTick_LOAD_RELOAD_Msk - SysTick->VAL) + \
+                                         capsense_idle_get_sleep_ticks()) & SysTick_LOAD_RELOAD_Msk)
+#else
+#define CAPSENSE_EVENT_TIMESTAMP()     (SysTick_LOAD_RELOAD_Msk - SysTick->VAL)
+#endif
+#define EVENT_USE_SYSTICK
+#endif
+
+#define EVENT_OVERFLOW_MAX             (0xFFFFu)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static capsense_event_ring_t *eventRing;
+static volatile uint8_t *eventTail;
+
+/* FSS status and suppressed touches of the last frame */
+static fss_bitmap_t lastStatus;
+static fss_bitmap_t lastSuppressed;
+
+static uint16_t frameCount;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void event_push(uint8_t sensor, uint8_t type, uint32_t timestamp);
+
+/*******************************************************************************
+* Function Name: capsense_event_init
+********************************************************************************
+* Summary:
+*  This function empties the ring. Call it after capsense_fss_init().
+*
+* Parameters:
+*  ring: the ring to fill
+*  tail: the read index of the consumer, which may be written by the host
+*
+*******************************************************************************/
+void capsense_event_init(capsense_event_ring_t *ring, volatile uint8_t *tail)
+{
+    eventRing = ring;
+    eventTail = tail;
+
+    eventRing->head = 0;
+    eventRing->overflow = 0;
+    *eventTail = 0;
+
+    for (uint32_t word = 0; word < FSS_WORD_COUNT; word++)
+    {
+        lastStatus.word[word] = 0;
+        lastSuppressed.word[word] = 0;
+    }
+    frameCount = 0;
+
+#ifdef EVENT_USE_SYSTICK
+    if (0u == (SysTick->CTRL & SysTick_CTRL_ENABLE_Msk))
+    {
+        SysTick->LOAD = SysTick_LOAD_RELOAD_Msk;
+        SysTick->VAL = 0u;
+        SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+    }
+#endif
+}
+
+
+/*******************************************************************************
+* Function Name: capsense_event_update
+********************************************************************************
+* Summary:
+*  This function queues the changes of the button status since the last
+*  frame: a press or release for each FSS button that turned on or off, and
+*  a suppressed event for each touch that FSS started suppressing. Call it
+*  once per frame after capsense_fss().
+*
+*******************************************************************************/
+void capsense_event_update(void)
+{
+    const fss_bitmap_t *status = capsense_fss_get_status();
+    const fss_bitmap_t *raw = capsense_fss_get_raw_status();
+    uint32_t timestamp = CAPSENSE_EVENT_TIMESTAMP();
+
+    for (uint32_t word = 0; word < FSS_WORD_COUNT; word++)
+    {
+        fss_word_t current = status->word[word];
+        fss_word_t suppressed = raw->word[word] & ~current;
+        fss_word_t changed = current ^ lastStatus.word[word];
+        fss_word_t newSuppressed = suppressed & ~lastSuppressed.word[word];
+        fss_word_t pending = changed | newSuppressed;
+
+        lastStatus.word[word] = current;
+        lastSuppressed.word[word] = suppressed;
+
+        /* Queuing in sensor order */
+        while (0u != pending)
+        {
+            uint8_t bit = fss_ctz(pending);
+            fss_word_t mask = (fss_word_t)1u << bit;
+            uint8_t sensor = (uint8_t)((word * FSS_WORD_BITS) + bit);
+
+            if (0u != (changed & mask))
+            {
+                event_push(sensor, (0u != (current & mask)) ? CAPSENSE_EVENT_PRESS : CAPSENSE_EVENT_RELEASE,
+                           timestamp);
+            }
+            if (0u != (newSuppressed & mask))
+            {
+                event_push(sensor, CAPSENSE_EVENT_SUPPRESSED, timestamp);
+            }
+            pending &= pending - 1u;
+        }
+    }
+
+    frameCount++;
+}
+
+
+/*******************************************************************************
+* Function Name: capsense_event_read
+********************************************************************************
+* Summary:
+*  This function takes the oldest event from the ring. Only one consumer may
+*  drain the ring: either the application with this function, or the host by
+*  writing the tail in the FSS control block.
+*
+* Parameters:
+*  event: where to copy the event
+*
+* Return:
+*  true if an event was read, false if the ring is empty.
+*
+*******************************************************************************/
+bool capsense_event_read(capsense_event_t *event)
+{
+    uint8_t tail = *eventTail;
+
+    if (tail == eventRing->head)
+    {
+        return false;
+    }
+
+    /* Reading the event only after seeing the head that publishes it */
+    __DMB();
+    *event = eventRing->event[tail & CAPSENSE_EVENT_RING_MASK];
+
+    /* Releasing the slot only after the event is copied */
+    __DMB();
+    *eventTail = (uint8_t)(tail + 1u);
+
+    return true;
+}
+
+
+/*******************************************************************************
+* Function Name: event_push
+********************************************************************************
+* Summary:
+*  This function appends an event, or counts it as dropped when the ring is
+*  full.
+*
+*******************************************************************************/
+static void event_push(uint8_t sensor, uint8_t type, uint32_t timestamp)
+{
+    uint8_t head = eventRing->head;
+    capsense_event_t *event;
+
+    if ((uint8_t)(head - *eventTail) >= CAPSENSE_EVENT_RING_SIZE)
+    {
+        if (eventRing->overflow < EVENT_OVERFLOW_MAX)
+        {
+            eventRing->overflow++;
+        }
+        return;
+    }
+
+    event = &eventRing->event[head & CAPSENSE_EVENT_RING_MASK];
+    event->sensor = sensor;
+    event->type = type;
+    event->frame = frameCount;
+    event->timestamp = timestamp;
+
+    /* Publishing the head only after the event is written */
+    __DMB();
+    eventRing->head = (uint8_t)(head + 1u);
+}
+
+
+/* [] END OF FILE */
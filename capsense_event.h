@@ -0,0 +1,104 @@
+/******************************************************************************
+* File Name: capsense_event.h
+*
+* Description: This file contains the event layout and the function prototypes
+*              of the touch event ring
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CAPSENSE_EVENT_H
+#define CAPSENSE_EVENT_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Number of events the ring holds; a power of two, up to 128 */
+#ifndef CAPSENSE_EVENT_RING_SIZE
+#define CAPSENSE_EVENT_RING_SIZE       (16u)
+#endif
+
+#if ((CAPSENSE_EVENT_RING_SIZE & (CAPSENSE_EVENT_RING_SIZE - 1u)) != 0u) || \
+    (CAPSENSE_EVENT_RING_SIZE > 128u) || (CAPSENSE_EVENT_RING_SIZE < 2u)
+#error "CAPSENSE_EVENT_RING_SIZE must be a power of two between 2 and 128"
+#endif
+
+#define CAPSENSE_EVENT_RING_MASK       (CAPSENSE_EVENT_RING_SIZE - 1u)
+
+/* Values of capsense_event_t.type */
+#define CAPSENSE_EVENT_PRESS           (0u)    /* The button turned on */
+#define CAPSENSE_EVENT_RELEASE         (1u)    /* The button turned off */
+#define CAPSENSE_EVENT_SUPPRESSED      (2u)    /* A touch started being suppressed by FSS */
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    uint8_t sensor;                 /* Button sensor index */
+    uint8_t type;                   /* CAPSENSE_EVENT_xxx */
+    uint16_t frame;                 /* Frame counter, wraps */
+    uint32_t timestamp;             /* CAPSENSE_EVENT_TIMESTAMP() at the end of the frame */
+} capsense_event_t;
+
+/* Single producer, single consumer ring. head and tail run freely and are
+ * reduced with CAPSENSE_EVENT_RING_MASK; the ring holds head - tail events.
+ * The producer only writes head and the events, the consumer only tail.
+ */
+typedef struct
+{
+    volatile uint8_t head;                      /* Written by the producer */
+    uint8_t reserved;
+    volatile uint16_t overflow;                 /* Events dropped on a full ring, saturating */
+    capsense_event_t event[CAPSENSE_EVENT_RING_SIZE];
+} capsense_event_ring_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void capsense_event_init(capsense_event_ring_t *ring, volatile uint8_t *tail);
+void capsense_event_update(void);
+bool capsense_event_read(capsense_event_t *event);
+
+#endif /* CAPSENSE_EVENT_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,766 @@
+/******************************************************************************
+* File Name: capsense_frame.c
+*
+* Description: This is the source code for the event driven CAPSENSE frame
+*              loop: the CPU sleeps while the sensors are scanned and is woken by
+*              the end-of-scan callback
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "capsense_frame.h"
+#include "capsense_capture.h"
+#include "capsense_event.h"
+#include "capsense_fss_algorithm.h"
+#include "capsense_fss_tuner.h"
+#include "capsense_idle.h"
+#include "capsense_profile.h"
+#include "fss_bitops.h"
+#include "cy_pdl.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#if (CAPSENSE_FRAME_PIPELINE != 0u) && (CY_CAPSENSE_WIDGET_COUNT > 1u)
+#define FRAME_PIPELINED
+#endif
+
+#if defined(FRAME_PIPELINED) && (CAPSENSE_FRAME_FOCUS != 0u)
+#define FRAME_FOCUSED
+#endif
+
+/* The wake-up widget gangs sensors that full-rate frames scan anyway, so
+ * these leave it out and scan the other widgets one at a time
+ */
+#if (CAPSENSE_IDLE_ENABLE != 0u) && defined(CAPSENSE_IDLE_WAKE_WIDGET)
+#define FRAME_WAKE_WIDGET
+#endif
+
+#if defined(FRAME_PIPELINED) || defined(FRAME_WAKE_WIDGET)
+#define FRAME_WIDGET_SCAN
+#endif
+
+/* First widget of a full-rate frame */
+#if defined(FRAME_WAKE_WIDGET) && (CAPSENSE_IDLE_WAKE_WIDGET == 0u)
+#define FRAME_FIRST_WIDGET             (1u)
+#else
+#define FRAME_FIRST_WIDGET             (0u)
+#endif
+
+#if defined(FRAME_WAKE_WIDGET) && (CY_CAPSENSE_WIDGET_COUNT < 2u)
+#error "CAPSENSE_IDLE_WAKE_WIDGET needs another widget to scan at full rate"
+#endif
+
+/* A skipped button keeps its last status, which must be the FSS result */
+#if defined(FRAME_FOCUSED) && (FSS_STATUS_WRITE_BACK == 0u)
+#error "CAPSENSE_FRAME_FOCUS needs FSS_STATUS_WRITE_BACK"
+#endif
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Set by the end-of-scan callback when the started scan is complete */
+static volatile bool scanDone = false;
+
+#ifdef FRAME_WIDGET_SCAN
+/* Widget being scanned */
+static uint32_t scanWidget;
+#endif
+
+#if (CAPSENSE_TUNER_PERIOD > 1u)
+/* Frames since the tuner was last serviced */
+static uint32_t tunerFrames;
+#endif
+
+#if (CAPSENSE_IDLE_ENABLE != 0u)
+/* Set while the loop runs wake-up scans */
+static bool idle;
+
+/* Frames in a row without an active widget, up to CAPSENSE_IDLE_TIMEOUT */
+static uint32_t quietFrames;
+#endif
+
+#ifdef FRAME_FOCUSED
+/* Index of the first button sensor of every widget and number of its button
+ * sensors, 0 for widgets that are always scanned
+ */
+static uint16_t widgetFirstButton[CY_CAPSENSE_WIDGET_COUNT];
+static uint8_t widgetButtons[CY_CAPSENSE_WIDGET_COUNT];
+
+/* Widgets skipped while the selection is held */
+static bool focusSkip[CY_CAPSENSE_WIDGET_COUNT];
+
+/* Button status focusSkip was built from, if focusValid */
+static fss_bitmap_t focusStatus;
+static bool focusValid;
+
+/* Frames since all widgets were last scanned */
+static uint32_t focusFrames;
+#endif
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void capsense_frame_end_of_scan(cy_stc_active_scan_sns_t *ptrActiveScan);
+static void capsense_frame_scan_first(void);
+static bool capsense_frame_step(void);
+static void capsense_frame_run_tuner(void);
+#if (CAPSENSE_IDLE_ENABLE != 0u)
+static bool capsense_frame_wake(void);
+static bool capsense_frame_update_quiet(void);
+#endif
+#ifdef FRAME_WIDGET_SCAN
+static uint32_t capsense_frame_next_widget(uint32_t widget);
+#endif
+#ifdef FRAME_FOCUSED
+static void capsense_frame_focus(void);
+static void capsense_frame_unfocus(void);
+#endif
+
+/*******************************************************************************
+* Function Name: capsense_frame_init
+********************************************************************************
+* Summary:
+*  This function registers the end-of-scan callback and clears the status
+*  map. Call it once after Cy_CapSense_Init() and capsense_fss_init().
+*
+*******************************************************************************/
+void capsense_frame_init(void)
+{
+#ifdef FRAME_FOCUSED
+    uint32_t buttonCount = capsense_fss_get_sensor_count();
+    uint32_t button = 0;
+
+    /* Locating the button sensors of FSS in every widget */
+    for (uint32_t widget = 0; widget < CY_CAPSENSE_WIDGET_COUNT; widget++)
+    {
+        uint32_t numSns = cy_capsense_context.ptrWdConfig[widget].numSns;
+
+        widgetFirstButton[widget] = (uint16_t)button;
+        widgetButtons[widget] = 0;
+
+        if (cy_capsense_context.ptrWdConfig[widget].wdType == CY_CAPSENSE_WD_BUTTON_E)
+        {
+            /* A widget with buttons beyond the FSS sensors is always scanned */
+            if ((button + numSns) <= buttonCount)
+            {
+                widgetButtons[widget] = (uint8_t)numSns;
+            }
+            button += numSns;
+        }
+    }
+#endif
+
+#if (CAPSENSE_STATUS_MAP_ENABLE != 0u)
+    capsense_status_map_init();
+#endif
+
+    (void)Cy_CapSense_RegisterCallback(CY_CAPSENSE_END_OF_SCAN_E, capsense_frame_end_of_scan,
+                                       &cy_capsense_context);
+
+#if (CAPSENSE_IDLE_ENABLE != 0u)
+    capsense_idle_init();
+#endif
+}
+
+
+/*******************************************************************************
+* Function Name: capsense_frame_start
+********************************************************************************
+* Summary:
+*  This function starts the scan of the first frame.
+*
+*******************************************************************************/
+void capsense_frame_start(void)
+{
+    scanDone = false;
+
+#if (CAPSENSE_TUNER_PERIOD > 1u)
+    tunerFrames = 0;
+#endif
+
+#ifdef FRAME_FOCUSED
+    capsense_frame_unfocus();
+#endif
+
+#if (CAPSENSE_IDLE_ENABLE != 0u)
+    idle = false;
+    quietFrames = 0;
+#endif
+
+    capsense_frame_scan_first();
+}
+
+
+/*******************************************************************************
+* Function Name: capsense_frame_wait
+********************************************************************************
+* Summary:
+*  This function puts the CPU to sleep until the started scan, of a frame or
+*  of one widget when pipelined, is complete. Interrupts
+*  are masked between testing the flag and WFI, so the end-of-scan interrupt
+*  cannot slip in between; a pending interrupt still wakes the CPU and is
+*  taken when interrupts are unmasked. Other interrupts, such as EZI2C, wake
+*  the CPU as well and it goes back to sleep.
+*  The CSD block needs the high frequency clock to scan, so the CPU uses
+*  Sleep rather than Deep Sleep.
+*
+*  In idle mode, the CPU is first put in Deep Sleep until the next wake-up
+*  scan, which is then started.
+*
+*******************************************************************************/
+void capsense_frame_wait(void)
+{
+#if (CAPSENSE_IDLE_ENABLE != 0u)
+    if (idle)
+    {
+        /* Deep Sleep until the next wake-up scan. SysTick stops, so the
+         * frame period across it is not profiled.
+         */
+#if (CAPSENSE_PROFILE_ENABLE != 0u)
+        capsense_profile_skip_frame();
+#endif
+        capsense_idle_sleep();
+#ifdef CAPSENSE_IDLE_WAKE_WIDGET
+        (void)Cy_CapSense_ScanWidget(CAPSENSE_IDLE_WAKE_WIDGET, &cy_capsense_context);
+#else
+        (void)Cy_CapSense_ScanAllWidgets(&cy_capsense_context);
+#endif
+    }
+#endif
+
+    __disable_irq();
+    while (!scanDone)
+    {
+        (void)Cy_SysPm_CpuEnterSleep();
+
+        /* Taking the interrupt that ended the sleep */
+        __enable_irq();
+        __disable_irq();
+    }
+    scanDone = false;
+    __enable_irq();
+}
+
+
+/*******************************************************************************
+* Function Name: capsense_frame_process
+********************************************************************************
+* Summary:
+*  This function processes the completed scan and starts the next one as
+*  soon as the hardware is free. Once the last widget of a frame is
+*  processed, it applies FSS, which runs while the next frame is scanned.
+*
+*  When pipelined, the next widget is scanned while the widget just scanned
+*  is processed, so the scan hardware is only idle between frames, while the
+*  tuner is serviced. The frame period is then the scan time of all widgets,
+*  and a touch reaches the button status one widget processing time after
+*  the end of the frame scan.
+*
+*  Otherwise, all widgets are processed before the next frame is scanned,
+*  because the scan writes the raw counts that the processing reads. The
+*  frame period is the scan time plus the processing time.
+*
+*  With CAPSENSE_IDLE_ENABLE, a quiet panel switches the loop to wake-up
+*  scans, and the first active one resumes full-rate scanning. With
+*  CAPSENSE_IDLE_WAKE_WIDGET, full-rate frames leave that widget out and scan
+*  the others one at a time, even when not pipelined.
+*
+*  With CAPSENSE_PROFILE_ENABLE, the processing (per widget when pipelined),
+*  tuner and FSS times and the frame period are recorded.
+*
+* Return:
+*  true if a frame is complete and the button status is updated.
+*
+*******************************************************************************/
+bool capsense_frame_process(void)
+{
+    uint32_t start;
+    bool frameEnd;
+
+#if (CAPSENSE_IDLE_ENABLE != 0u)
+    frameEnd = idle ? capsense_frame_wake() : capsense_frame_step();
+#else
+    frameEnd = capsense_frame_step();
+#endif
+
+    if (!frameEnd)
+    {
+        return false;
+    }
+
+    /* Apply FSS algorithm */
+    start = capsense_profile_start();
+    capsense_fss();
+    capsense_profile_stop(CAPSENSE_PROFILE_FSS, start);
+
+    /* Queue the button changes as touch events */
+    capsense_event_update();
+
+#if (CAPSENSE_CAPTURE_ENABLE != 0u)
+    /* Record the frame in the trace capture if the status changed */
+    capsense_capture_update();
+#endif
+
+#ifdef FRAME_FOCUSED
+    /* Choose the widgets to scan in the next frame */
+    capsense_frame_focus();
+#endif
+
+    /* Apply host FSS settings and publish the FSS status */
+    capsense_fss_tuner_update();
+
+#if (CAPSENSE_STATUS_MAP_ENABLE != 0u)
+    /* Publish the button status to the status map */
+    capsense_status_map_update();
+#endif
+
+#if (CAPSENSE_PROFILE_ENABLE != 0u)
+    capsense_profile_frame();
+#endif
+
+    return true;
+}
+
+
+/*******************************************************************************
+* Function Name: capsense_frame_step
+********************************************************************************
+* Summary:
+*  Processes the completed scan and starts the next one. With the idle mode,
+*  once no widget has been active for CAPSENSE_IDLE_TIMEOUT frames, the next
+*  frame is not started and the loop turns to wake-up scans. When pipelined,
+*  the next frame would start before the last widget is processed, so it is
+*  held back past the timeout until that widget shows whether to go idle.
+*
+* Return:
+*  true if a frame is complete.
+*
+*******************************************************************************/
+static bool capsense_frame_step(void)
+{
+    uint32_t start;
+
+#ifdef FRAME_PIPELINED
+    uint32_t scannedWidget = scanWidget;
+    bool frameEnd;
+    bool holdFrame = false;
+
+    scanWidget = capsense_frame_next_widget(scannedWidget + 1u);
+    frameEnd = (CY_CAPSENSE_WIDGET_COUNT == scanWidget);
+    if (frameEnd)
+    {
+        scanWidget = FRAME_FIRST_WIDGET;
+        capsense_frame_run_tuner();
+#if (CAPSENSE_IDLE_ENABLE != 0u)
+        holdFrame = (quietFrames >= CAPSENSE_IDLE_TIMEOUT);
+#endif
+    }
+
+    /* Start the next widget scan before processing the widget just scanned */
+    if (!holdFrame)
+    {
+        (void)Cy_CapSense_ScanWidget(scanWidget, &cy_capsense_context);
+    }
+
+    start = capsense_profile_start();
+    (void)Cy_CapSense_ProcessWidget(scannedWidget, &cy_capsense_context);
+    capsense_profile_stop(CAPSENSE_PROFILE_PROCESS, start);
+
+    if (!frameEnd)
+    {
+        return false;
+    }
+
+#if (CAPSENSE_IDLE_ENABLE != 0u)
+    idle = capsense_frame_update_quiet() && holdFrame;
+    if (holdFrame && !idle)
+    {
+        capsense_frame_scan_first();
+    }
+#endif
+#else
+#ifdef FRAME_WAKE_WIDGET
+    /* Scan the next widget of the frame, if any */
+    scanWidget = capsense_frame_next_widget(scanWidget + 1u);
+    if (scanWidget < CY_CAPSENSE_WIDGET_COUNT)
+    {
+        (void)Cy_CapSense_ScanWidget(scanWidget, &cy_capsense_context);
+        return false;
+    }
+#endif
+
+    /* Process all widgets */
+    start = capsense_profile_start();
+#ifdef FRAME_WAKE_WIDGET
+    for (uint32_t widget = 0; widget < CY_CAPSENSE_WIDGET_COUNT; widget++)
+    {
+        if (CAPSENSE_IDLE_WAKE_WIDGET != widget)
+        {
+            (void)Cy_CapSense_ProcessWidget(widget, &cy_capsense_context);
+        }
+    }
+#else
+    Cy_CapSense_ProcessAllWidgets(&cy_capsense_context);
+#endif
+    capsense_profile_stop(CAPSENSE_PROFILE_PROCESS, start);
+
+    capsense_frame_run_tuner();
+
+#if (CAPSENSE_IDLE_ENABLE != 0u)
+    idle = capsense_frame_update_quiet();
+    if (!idle)
+#endif
+    {
+        /* Start the next scan; the scan only writes the raw counts */
+        capsense_frame_scan_first();
+    }
+#endif
+
+    return true;
+}
+
+
+/*******************************************************************************
+* Function Name: capsense_frame_scan_first
+********************************************************************************
+* Summary:
+*  Starts the scan of a full-rate frame, of its first widget when pipelined
+*  or when the wake-up widget is left out.
+*
+*******************************************************************************/
+static void capsense_frame_scan_first(void)
+{
+#ifdef FRAME_WIDGET_SCAN
+    scanWidget = FRAME_FIRST_WIDGET;
+    (void)Cy_CapSense_ScanWidget(scanWidget, &cy_capsense_context);
+#else
+    (void)Cy_CapSense_ScanAllWidgets(&cy_capsense_context);
+#endif
+}
+
+
+#if (CAPSENSE_IDLE_ENABLE != 0u)
+/*******************************************************************************
+* Function Name: capsense_frame_wake
+********************************************************************************
+* Summary:
+*  Processes a wake-up scan. If a widget is active, full-rate scanning
+*  resumes at once. A wake-up scan of all widgets is a complete frame, so
+*  FSS reports the touch right away; after a scan of CAPSENSE_IDLE_WAKE_WIDGET
+*  only, it does so at the end of the next frame.
+*
+* Return:
+*  true if a frame is complete.
+*
+*******************************************************************************/
+static bool capsense_frame_wake(void)
+{
+#ifdef CAPSENSE_IDLE_WAKE_WIDGET
+    (void)Cy_CapSense_ProcessWidget(CAPSENSE_IDLE_WAKE_WIDGET, &cy_capsense_context);
+    if (0u == Cy_CapSense_IsWidgetActive(CAPSENSE_IDLE_WAKE_WIDGET, &cy_capsense_context))
+    {
+        return false;
+    }
+#else
+    Cy_CapSense_ProcessAllWidgets(&cy_capsense_context);
+    if (0u == Cy_CapSense_IsAnyWidgetActive(&cy_capsense_context))
+    {
+        return false;
+    }
+#endif
+
+    idle = false;
+    quietFrames = 0;
+    capsense_frame_scan_first();
+
+#ifdef CAPSENSE_IDLE_WAKE_WIDGET
+    return false;
+#else
+    return true;
+#endif
+}
+
+
+/*******************************************************************************
+* Function Name: capsense_frame_update_quiet
+********************************************************************************
+* Summary:
+*  Counts the frames in a row without an active widget. Call it once all
+*  widgets of a frame are processed. The wake-up widget is not scanned at
+*  full rate, so it keeps the active status that ended the idle mode and is
+*  not counted.
+*
+* Return:
+*  true if no widget has been active for CAPSENSE_IDLE_TIMEOUT frames.
+*
+*******************************************************************************/
+static bool capsense_frame_update_quiet(void)
+{
+    bool active = false;
+
+#ifdef FRAME_WAKE_WIDGET
+    for (uint32_t widget = 0; widget < CY_CAPSENSE_WIDGET_COUNT; widget++)
+    {
+        active |= ((CAPSENSE_IDLE_WAKE_WIDGET != widget) &&
+                   (0u != Cy_CapSense_IsWidgetActive(widget, &cy_capsense_context)));
+    }
+#else
+    active = (0u != Cy_CapSense_IsAnyWidgetActive(&cy_capsense_context));
+#endif
+
+    if (active)
+    {
+        quietFrames = 0;
+    }
+    else if (quietFrames < CAPSENSE_IDLE_TIMEOUT)
+    {
+        quietFrames++;
+    }
+
+    return (quietFrames >= CAPSENSE_IDLE_TIMEOUT);
+}
+#endif
+
+
+/*******************************************************************************
+* Function Name: capsense_frame_run_tuner
+********************************************************************************
+* Summary:
+*  Services the CAPSENSE tuner once every CAPSENSE_TUNER_PERIOD frames.
+*
+*******************************************************************************/
+static void capsense_frame_run_tuner(void)
+{
+#if (CAPSENSE_TUNER_PERIOD != 0u)
+    uint32_t start;
+
+#if (CAPSENSE_TUNER_PERIOD > 1u)
+    if (++tunerFrames < CAPSENSE_TUNER_PERIOD)
+    {
+        return;
+    }
+    tunerFrames = 0;
+#endif
+
+    /* Establishes synchronized communication with the CapSense Tuner tool */
+    start = capsense_profile_start();
+    Cy_CapSense_RunTuner(&cy_capsense_context);
+    capsense_profile_stop(CAPSENSE_PROFILE_TUNER, start);
+#endif
+}
+
+
+#ifdef FRAME_WIDGET_SCAN
+/*******************************************************************************
+* Function Name: capsense_frame_next_widget
+********************************************************************************
+* Summary:
+*  Returns the first widget to scan from widget on, or CY_CAPSENSE_WIDGET_COUNT
+*  after the last widget of the frame. The wake-up widget and, in focused
+*  mode, the skipped widgets are passed over.
+*
+*******************************************************************************/
+static uint32_t capsense_frame_next_widget(uint32_t widget)
+{
+    for (; widget < CY_CAPSENSE_WIDGET_COUNT; widget++)
+    {
+        bool skip = false;
+
+#ifdef FRAME_WAKE_WIDGET
+        skip |= (CAPSENSE_IDLE_WAKE_WIDGET == widget);
+#endif
+#ifdef FRAME_FOCUSED
+        skip |= focusSkip[widget];
+#endif
+        if (!skip)
+        {
+            break;
+        }
+    }
+
+    return widget;
+}
+#endif
+
+
+#ifdef FRAME_FOCUSED
+/*******************************************************************************
+* Function Name: capsense_frame_focus
+********************************************************************************
+* Summary:
+*  Chooses the widgets to scan from the FSS result of the frame. While FSS
+*  holds a selected button, the other buttons of its group cannot be
+*  selected, so a widget whose button sensors are all such buttons is
+*  skipped, unless a sensor is a neighbour of a selected button. Their status
+*  stays as FSS left it, cleared. The neighbours are the ones listed in the
+*  neighbour table when one is loaded, since bit order need not follow the
+*  panel layout; with groups, they are the sensors within
+*  CAPSENSE_FRAME_FOCUS_NEIGHBOURS bits of the selected button. With a
+*  neighbour table, the buttons a selection locks are its own neighbours, so
+*  all widgets are then scanned. Widgets
+*  without FSS buttons are always scanned. Once the selection is released,
+*  all widgets are scanned again. The set is rebuilt only when the button
+*  status changes, and every CAPSENSE_FRAME_FOCUS_REFRESH frames all widgets
+*  are scanned, which also picks up FSS settings changed by the host.
+*
+*  The first widget is always scanned: its scan starts the next frame before
+*  FSS runs, so the widgets to skip are only chosen from the next one on. A button
+*  that FSS did not select has its status cleared, which is what a skipped
+*  button keeps, so a skipped button never shows as touched.
+*
+*  A skipped button cannot be scanned again in the frame that releases the
+*  selection: FSS runs once the frame is scanned, after the next frame has
+*  started. A button touched while skipped is therefore reported one frame
+*  after the release, one frame later than with full scans.
+*
+*******************************************************************************/
+static void capsense_frame_focus(void)
+{
+    const fss_bitmap_t *status = capsense_fss_get_status();
+    uint32_t buttonCount = capsense_fss_get_sensor_count();
+    const fss_bitmap_t *neighbours;
+    uint32_t neighbourCount = capsense_fss_get_neighbours(&neighbours);
+    fss_bitmap_t locked;
+    bool changed = false;
+    uint32_t word;
+
+    if (++focusFrames >= CAPSENSE_FRAME_FOCUS_REFRESH)
+    {
+        capsense_frame_unfocus();
+        return;
+    }
+
+    for (word = 0; word < FSS_WORD_COUNT; word++)
+    {
+        changed |= (status->word[word] != focusStatus.word[word]);
+    }
+    if (focusValid && !changed)
+    {
+        return;
+    }
+    focusStatus = *status;
+    focusValid = true;
+
+    capsense_fss_get_locked_mask(&locked);
+
+    /* Keeping the neighbours of the selected buttons */
+    for (word = 0; word < FSS_WORD_COUNT; word++)
+    {
+        fss_word_t selected = status->word[word];
+
+        while (0u != selected)
+        {
+            uint32_t button = (word * FSS_WORD_BITS) + fss_ctz(selected);
+
+            if (NULL != neighbours)
+            {
+                /* The buttons beyond the table have no neighbours */
+                for (uint32_t other = 0; (button < neighbourCount) && (other < FSS_WORD_COUNT); other++)
+                {
+                    locked.word[other] &= ~neighbours[button].word[other];
+                }
+            }
+            else
+            {
+                uint32_t first = (button > CAPSENSE_FRAME_FOCUS_NEIGHBOURS) ?
+                                 (button - CAPSENSE_FRAME_FOCUS_NEIGHBOURS) : 0u;
+
+                for (uint32_t sensor = first; (sensor <= (button + CAPSENSE_FRAME_FOCUS_NEIGHBOURS)) &&
+                                              (sensor < buttonCount); sensor++)
+                {
+                    locked.word[sensor / FSS_WORD_BITS] &= ~((fss_word_t)1u << (sensor % FSS_WORD_BITS));
+                }
+            }
+            selected &= selected - 1u;
+        }
+    }
+
+    for (uint32_t widget = 0; widget < CY_CAPSENSE_WIDGET_COUNT; widget++)
+    {
+        bool skip = (0u != widgetButtons[widget]);
+
+        for (uint32_t sensor = widgetFirstButton[widget];
+             skip && (sensor < (widgetFirstButton[widget] + widgetButtons[widget])); sensor++)
+        {
+            skip = (0u != (locked.word[sensor / FSS_WORD_BITS] & ((fss_word_t)1u << (sensor % FSS_WORD_BITS))));
+        }
+        focusSkip[widget] = skip;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: capsense_frame_unfocus
+********************************************************************************
+* Summary:
+*  Scans all widgets from the next widget on.
+*
+*******************************************************************************/
+static void capsense_frame_unfocus(void)
+{
+    for (uint32_t widget = 0; widget < CY_CAPSENSE_WIDGET_COUNT; widget++)
+    {
+        focusSkip[widget] = false;
+    }
+    focusValid = false;
+    focusFrames = 0;
+}
+#endif
+
+
+/*******************************************************************************
+* Function Name: capsense_frame_end_of_scan
+********************************************************************************
+* Summary:
+*  End-of-scan callback, called from capsense_isr(). Flags the scan as
+*  done once its last sensor is scanned.
+*
+*******************************************************************************/
+static void capsense_frame_end_of_scan(cy_stc_active_scan_sns_t *ptrActiveScan)
+{
+    (void)ptrActiveScan;
+
+    if (CY_CAPSENSE_NOT_BUSY == Cy_CapSense_IsBusy(&cy_capsense_context))
+    {
+        scanDone = true;
+    }
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,106 @@
+/******************************************************************************
+* File Name: capsense_frame.h
+*
+* Description: This file contains the function prototypes of the event
+*              driven CAPSENSE frame loop
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CAPSENSE_FRAME_H
+#define CAPSENSE_FRAME_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdbool.h>
+#include "cycfg_capsense.h"
+#include "capsense_status_map.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Set to 1 to scan the widgets one at a time and process each scanned widget
+ * while the next one is scanned, or 0 to scan all widgets at once and process
+ * them between frames. Pipelining needs at least two widgets.
+ */
+#ifndef CAPSENSE_FRAME_PIPELINE
+#define CAPSENSE_FRAME_PIPELINE        (1u)
+#endif
+
+/* Set to 1 to skip, while FSS holds a selected button, the widgets whose
+ * button sensors can only be suppressed by it. Needs the pipelined loop.
+ * The neighbours of a selected button are still scanned: those of the
+ * neighbour table if one is loaded, else the sensors within
+ * CAPSENSE_FRAME_FOCUS_NEIGHBOURS bits of it. Every
+ * CAPSENSE_FRAME_FOCUS_REFRESH frames all widgets are scanned. Refer
+ * README.md.
+ */
+#ifndef CAPSENSE_FRAME_FOCUS
+#define CAPSENSE_FRAME_FOCUS           (0u)
+#endif
+
+#ifndef CAPSENSE_FRAME_FOCUS_NEIGHBOURS
+#define CAPSENSE_FRAME_FOCUS_NEIGHBOURS    (1u)
+#endif
+
+#ifndef CAPSENSE_FRAME_FOCUS_REFRESH
+#define CAPSENSE_FRAME_FOCUS_REFRESH   (32u)
+#endif
+
+/* Cy_CapSense_RunTuner() is called once every CAPSENSE_TUNER_PERIOD frames,
+ * or never with 0. The tuner is not reachable when the status map takes the
+ * EZI2C primary address, so it is not serviced by default then.
+ */
+#ifndef CAPSENSE_TUNER_PERIOD
+#if (CAPSENSE_STATUS_MAP_ENABLE != 0u)
+#define CAPSENSE_TUNER_PERIOD          (0u)
+#else
+#define CAPSENSE_TUNER_PERIOD          (1u)
+#endif
+#endif
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void capsense_frame_init(void);
+void capsense_frame_start(void);
+void capsense_frame_wait(void);
+bool capsense_frame_process(void);
+
+#endif /* CAPSENSE_FRAME_H */
+
+
+/* [] END OF FILE */
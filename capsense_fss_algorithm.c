@@ -42,122 +42,1197 @@
 /*******************************************************************************
  * Include header files
  ******************************************************************************/
+#include <stddef.h>
 #include "capsense_fss_algorithm.h"
+#include "fss_bitops.h"
 
 /*******************************************************************************
 * Macros
 *******************************************************************************/
-#define CURRENTBUTTONSTATUS_LSB_MASK   (0x0000000000000001u)
-#define RIGHT_SHIFT_1BIT               (1u)
+#define WORD_LSB_MASK                  (0x00000001u)
+#define WORD_MSB_SHIFT                 (31u)
 
-/* Modify FSS_ENABLE_MASK if the FSS algorithm needs to be applied to only
- * certain buttons. Refer README.md for more instructions.
+/* Number of doubling steps that spread a bit over a 32-bit word */
+#define SPREAD_STEPS                   (5u)
+
+/* Number of buttons selected at once in a group */
+#if (FSS_ARRIVAL_ORDER != 0u)
+#define FSS_GROUP_WINNERS              (FSS_MAX_WINNERS)
+#else
+#define FSS_GROUP_WINNERS              (1u)
+#endif
+
+/* Define FSS_ENABLE_MASK if the FSS algorithm needs to be applied to only
+ * certain buttons. It lists the 32-bit words of the mask, lowest sensors
+ * first, e.g. (0x00000005u) or 0xFFFFFFFFu, 0x0000000Fu. If it is not
+ * defined, FSS is applied on all buttons. Refer README.md for more
+ * instructions.
+ */
+/* #define FSS_ENABLE_MASK             (0x00000007u) */
+
+/* Define FSS_GROUP_TABLE to split the FSS enabled buttons into independent
+ * groups, each with its own selected button. Every entry is
+ * { firstSensor, sensorCount } for a run of consecutive button sensors, in
+ * ascending order and not overlapping, e.g. one group per keypad row:
+ * { 0u, 4u }, { 4u, 4u }, { 8u, 4u }. If it is not defined, all FSS enabled
+ * buttons form one group. Refer README.md for more instructions.
  */
-#define FSS_ENABLE_MASK                ((1 << sensorCount) - 1)
+/* #define FSS_GROUP_TABLE             { 0u, 2u }, { 2u, 1u } */
+
+/* Define FSS_NEIGHBOUR_TABLE to suppress a touch only on the physical
+ * neighbours of the selected buttons instead of in a whole group, so that
+ * keys far apart can be pressed together. It lists one bitmap per button
+ * sensor, lowest sensors first, with a bit set for every neighbour, e.g.
+ * three keys in a row: { { 0x2u } }, { { 0x5u } }, { { 0x2u } }. Neighbours
+ * must be listed both ways. It takes precedence over the group table.
+ * Refer README.md for more instructions.
+ */
+/* #define FSS_NEIGHBOUR_TABLE         { { 0x2u } }, { { 0x5u } }, { { 0x2u } } */
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Per-word masks derived from the group table by capsense_fss_set_groups().
+ * A group covers a run of consecutive bits; buttons in the run that are not
+ * FSS enabled are passed through unchanged.
+ */
+typedef struct
+{
+    fss_word_t member[FSS_WORD_COUNT];               /* FSS enabled bits of all groups */
+    fss_word_t low[FSS_WORD_COUNT];                  /* Lowest bit of every group */
+    fss_word_t top[FSS_WORD_COUNT];                  /* Highest bit of every group */
+    fss_word_t body[FSS_WORD_COUNT];                 /* Every group bit except the highest */
+    fss_word_t join[SPREAD_STEPS][FSS_WORD_COUNT];   /* Bit N set if bit N + 2^step is in its group */
+    fss_word_t carry[FSS_WORD_COUNT];                /* Bit 31 set if its group goes on in the next word */
+} fss_group_masks_t;
 
 /*******************************************************************************
 * Global Variables
 *******************************************************************************/
-uint64_t currentButtonStatus    = 0;
-uint64_t previousButtonStatus   = 0;
-uint8_t  sensorCount            = 0;
+fss_bitmap_t currentButtonStatus;
+fss_bitmap_t previousButtonStatus;
+fss_bitmap_t rawButtonStatus;
+fss_bitmap_t changedButtonStatus;
+
+/* Number of button sensors found by capsense_fss_init() */
+static uint8_t sensorCount = 0;
+
+/* Sensor context of every button sensor, indexed by its bit position in
+ * currentButtonStatus. Generated from the design when FSS_BUTTON_SENSOR_TABLE
+ * is defined, else filled once by capsense_fss_init().
+ */
+#ifdef FSS_BUTTON_SENSOR_TABLE
+static cy_stc_capsense_sensor_context_t * const buttonSensor[FSS_SENSOR_COUNT] = { FSS_BUTTON_SENSOR_TABLE };
+#else
+static cy_stc_capsense_sensor_context_t * buttonSensor[FSS_SENSOR_COUNT];
+#endif
+
+#if (FSS_DIFF_ARBITRATION != 0u)
+/* Difference count of every button sensor, read with the status */
+static uint16_t buttonDiff[FSS_SENSOR_COUNT];
+#endif
+
+#if (FSS_ARRIVAL_ORDER != 0u)
+/* Value of fssArrivalClock in the frame where the touch of every button
+ * sensor started. The clock advances once per frame with a new touch, and
+ * ages are compared modulo 2^16.
+ */
+static uint16_t fssArrival[FSS_SENSOR_COUNT];
+static uint16_t fssArrivalClock;
+#endif
+
+/* Starts as FSS_ENABLE_MASK and can be changed by capsense_fss_set_enable_mask() */
+#ifdef FSS_ENABLE_MASK
+static fss_bitmap_t fssEnableMask = { { FSS_ENABLE_MASK } };
+#else
+static fss_bitmap_t fssEnableMask;
+#endif
+
+/* The loaded group table, kept to rebuild the masks on an enable mask change */
+static fss_group_t fssGroupTable[FSS_MAX_GROUP_COUNT];
+static uint8_t fssGroupCount;
+
+static fss_group_masks_t fssGroups;
+
+/* The loaded neighbour table, NULL to select among groups */
+static const fss_bitmap_t *fssNeighbours;
+static uint8_t fssNeighbourCount;
+
+/* Set once previousButtonStatus holds the FSS result of rawButtonStatus */
+static bool fssResultValid = false;
 
 /*******************************************************************************
 * Function Prototypes
 *******************************************************************************/
-static uint64_t fss_algorithm(uint64_t , uint64_t);
+static bool fss_build_masks(const fss_group_t *, uint8_t, fss_group_masks_t *);
+#if (FSS_ARRIVAL_ORDER != 0u)
+static void fss_algorithm_arrival(fss_bitmap_t *, const fss_bitmap_t *);
+static void fss_stamp_arrivals(const fss_bitmap_t *status);
+#else
+static void fss_algorithm(fss_bitmap_t *, const fss_bitmap_t *);
+#endif
+static void fss_algorithm_adjacent(fss_bitmap_t *, const fss_bitmap_t *);
+static bool fss_check_neighbours(const fss_bitmap_t *, uint8_t);
+static uint8_t fss_next_candidate(const fss_word_t *candidates);
+#if ((FSS_DIFF_ARBITRATION != 0u) || (FSS_ARRIVAL_ORDER != 0u))
+static bool fss_precedes(uint8_t sensor, uint8_t other);
+#endif
+#if ((FSS_DIFF_ARBITRATION != 0u) && (FSS_ARRIVAL_ORDER == 0u))
+static void fss_arbitrate(fss_word_t *status, const fss_word_t *active, const fss_word_t *selected);
+#endif
+static fss_word_t fss_range_mask(uint8_t word, uint16_t first, uint16_t last);
 
 /*******************************************************************************
-* Function Name: capsense_fss
+* Function Name: add_carry
 ********************************************************************************
 * Summary:
-*  This function applies the FSS algorithm on the button sensors. When
-*  multiple sensors with FSS enabled are touched, the sensor touched first is 
-*  given the higher priority.
+*  Returns a + b + *carry and leaves the carry out of bit 31 in *carry, so
+*  that the status words add up like one wide integer.
 *
 *******************************************************************************/
-void capsense_fss(void)
+static inline fss_word_t add_carry(fss_word_t a, fss_word_t b, fss_word_t *carry)
+{
+    fss_word_t sum = a + b;
+    fss_word_t result = sum + *carry;
+
+    *carry = (fss_word_t)((sum < a) || (result < sum));
+    return result;
+}
+
+
+/*******************************************************************************
+* Function Name: sub_borrow
+********************************************************************************
+* Summary:
+*  Returns a - b - *borrow and leaves the borrow out of bit 31 in *borrow.
+*
+*******************************************************************************/
+static inline fss_word_t sub_borrow(fss_word_t a, fss_word_t b, fss_word_t *borrow)
 {
-    /* Clearing currentButtonStatus and sensorCount for the next iteration */
-    currentButtonStatus = 0;
+    fss_word_t difference = a - b;
+    fss_word_t result = difference - *borrow;
+
+    *borrow = (fss_word_t)((a < b) || (difference < *borrow));
+    return result;
+}
+
+
+/*******************************************************************************
+* Function Name: capsense_fss_init
+********************************************************************************
+* Summary:
+*  This function walks the widgets once and records the sensor context of
+*  every button sensor in the order of its bit in the button status. The
+*  widget layout does not change after Cy_CapSense_Init(), so capsense_fss()
+*  can then gather and scatter the statuses without a widget walk. With
+*  FSS_BUTTON_SENSOR_TABLE, the table is generated from the design and there
+*  is no walk at all. It then loads FSS_GROUP_TABLE, or a single group of all
+*  buttons, and FSS_NEIGHBOUR_TABLE if defined.
+*
+*******************************************************************************/
+void capsense_fss_init(void)
+{
+#ifdef FSS_GROUP_TABLE
+    static const fss_group_t groupTable[] = { FSS_GROUP_TABLE };
+#else
+    fss_group_t allButtons;
+#endif
+#ifdef FSS_NEIGHBOUR_TABLE
+    static const fss_bitmap_t neighbourTable[] = { FSS_NEIGHBOUR_TABLE };
+#endif
+
+    fssNeighbours = NULL;
+
+#ifdef FSS_BUTTON_SENSOR_TABLE
+    sensorCount = FSS_SENSOR_COUNT;
+#else
     sensorCount = 0;
 
-    /* Extracting current button statuses and counting the total number of sensors */
     for (uint8_t widget = 0; widget < CY_CAPSENSE_WIDGET_COUNT; widget++)
     {
         if (cy_capsense_context.ptrWdConfig[widget].wdType == CY_CAPSENSE_WD_BUTTON_E)
         {
-            for (uint8_t sensor_iter = 0; sensor_iter < cy_capsense_context.ptrWdConfig[widget].numSns; sensor_iter++)
+            for (uint8_t sensor_iter = 0; (sensor_iter < cy_capsense_context.ptrWdConfig[widget].numSns) &&
+                                          (sensorCount < FSS_SENSOR_COUNT); sensor_iter++)
             {
-                currentButtonStatus |= ( (cy_capsense_context.ptrWdConfig[widget].ptrSnsContext[sensor_iter].status &
-                                       CY_CAPSENSE_SNS_TOUCH_STATUS_MASK) << sensorCount);
+                buttonSensor[sensorCount] = &cy_capsense_context.ptrWdConfig[widget].ptrSnsContext[sensor_iter];
                 sensorCount++;
             }
         }
     }
+#endif
 
-    /* Applying FSS algorithm */
-    currentButtonStatus = fss_algorithm(currentButtonStatus,previousButtonStatus);
+#ifndef FSS_ENABLE_MASK
+    /* FSS algorithm is applied on all buttons */
+    for (uint8_t word = 0; word < FSS_WORD_COUNT; word++)
+    {
+        if (sensorCount >= ((word + 1u) * FSS_WORD_BITS))
+        {
+            fssEnableMask.word[word] = ~(fss_word_t)0;
+        }
+        else if (sensorCount > (word * FSS_WORD_BITS))
+        {
+            fssEnableMask.word[word] = ((fss_word_t)WORD_LSB_MASK << (sensorCount % FSS_WORD_BITS)) - 1u;
+        }
+        else
+        {
+            fssEnableMask.word[word] = 0;
+        }
+    }
+#endif
 
-    /* Storing the current button statuses in previousButtonStatus for the next iteration */
-    previousButtonStatus = currentButtonStatus;
+#ifdef FSS_GROUP_TABLE
+    (void)capsense_fss_set_groups(groupTable, (uint8_t)(sizeof(groupTable) / sizeof(groupTable[0])));
+#else
+    allButtons.firstSensor = 0;
+    allButtons.sensorCount = sensorCount;
+    (void)capsense_fss_set_groups(&allButtons, 1);
+#endif
 
-    /* Updating the button statuses obtained after the application of FSS algorithm */
-    for (uint8_t widget = 0; widget < CY_CAPSENSE_WIDGET_COUNT; widget++)
+#ifdef FSS_NEIGHBOUR_TABLE
+    (void)capsense_fss_set_neighbours(neighbourTable,
+                                      (uint8_t)(sizeof(neighbourTable) / sizeof(neighbourTable[0])));
+#endif
+}
+
+
+/*******************************************************************************
+* Function Name: capsense_fss_get_sensor_count
+********************************************************************************
+* Summary:
+*  This function returns the number of button sensors, which is the number
+*  of valid bits in the button status.
+*
+*******************************************************************************/
+uint8_t capsense_fss_get_sensor_count(void)
+{
+    return sensorCount;
+}
+
+
+/*******************************************************************************
+* Function Name: capsense_fss_set_groups
+********************************************************************************
+* Summary:
+*  This function loads a group table and derives the per-word masks that
+*  fss_algorithm() evaluates all groups with. Each group is a run of
+*  consecutive button sensors; groups must be given in ascending order and
+*  must not overlap. The FSS selection starts over from the next frame.
+*
+* Parameters:
+*  groups: the group table
+*  groupCount: number of entries in the table, at most FSS_MAX_GROUP_COUNT
+*
+* Return:
+*  true if the table was loaded, false if it is invalid (the previous table
+*  is kept).
+*
+*******************************************************************************/
+bool capsense_fss_set_groups(const fss_group_t *groups, uint8_t groupCount)
+{
+    fss_group_masks_t masks = { 0 };
+
+    if ((groupCount > FSS_MAX_GROUP_COUNT) || !fss_build_masks(groups, groupCount, &masks))
     {
-        if (cy_capsense_context.ptrWdConfig[widget].wdType == CY_CAPSENSE_WD_BUTTON_E)
+        return false;
+    }
+
+    for (uint8_t group = 0; group < groupCount; group++)
+    {
+        fssGroupTable[group] = groups[group];
+    }
+    fssGroupCount = groupCount;
+
+    fssGroups = masks;
+    for (uint8_t word = 0; word < FSS_WORD_COUNT; word++)
+    {
+        previousButtonStatus.word[word] = 0;
+    }
+    fssResultValid = false;
+
+    return true;
+}
+
+
+/*******************************************************************************
+* Function Name: capsense_fss_set_enable_mask
+********************************************************************************
+* Summary:
+*  This function replaces the FSS enable mask at run time and rebuilds the
+*  group masks from the loaded group table. Buttons outside the mask are
+*  passed through unchanged. The FSS selection starts over from the next
+*  frame.
+*
+* Parameters:
+*  mask: one bit per button sensor, set to apply FSS on the button
+*
+*******************************************************************************/
+void capsense_fss_set_enable_mask(const fss_bitmap_t *mask)
+{
+    fssEnableMask = *mask;
+    (void)capsense_fss_set_groups(fssGroupTable, fssGroupCount);
+}
+
+
+/*******************************************************************************
+* Function Name: capsense_fss_get_enable_mask
+********************************************************************************
+* Summary:
+*  This function returns the FSS enable mask in use.
+*
+*******************************************************************************/
+const fss_bitmap_t *capsense_fss_get_enable_mask(void)
+{
+    return &fssEnableMask;
+}
+
+
+/*******************************************************************************
+* Function Name: capsense_fss_get_groups
+********************************************************************************
+* Summary:
+*  This function returns the loaded group table and its number of entries.
+*
+*******************************************************************************/
+uint8_t capsense_fss_get_groups(const fss_group_t **groups)
+{
+    *groups = fssGroupTable;
+    return fssGroupCount;
+}
+
+
+/*******************************************************************************
+* Function Name: capsense_fss_set_neighbours
+********************************************************************************
+* Summary:
+*  This function loads a neighbour table, which replaces the groups: a
+*  touch is then only suppressed by a selected button that lists it as a
+*  neighbour. The table is used in place, so it must stay valid while it is
+*  loaded. Button sensors beyond the table are passed through unchanged.
+*  The FSS selection starts over from the next frame.
+*
+* Parameters:
+*  neighbours: one bitmap of neighbours per button sensor, lowest first, or
+*   NULL to go back to the group table
+*  neighbourCount: number of entries in the table, at most the number of
+*   button sensors
+*
+* Return:
+*  true if the table was loaded, false if it is invalid (the previous table
+*  is kept).
+*
+*******************************************************************************/
+bool capsense_fss_set_neighbours(const fss_bitmap_t *neighbours, uint8_t neighbourCount)
+{
+    if ((NULL != neighbours) && !fss_check_neighbours(neighbours, neighbourCount))
+    {
+        return false;
+    }
+
+    fssNeighbours = neighbours;
+    fssNeighbourCount = neighbourCount;
+
+    /* Rebuilding the masks for the new FSS buttons */
+    return capsense_fss_set_groups(fssGroupTable, fssGroupCount);
+}
+
+
+/*******************************************************************************
+* Function Name: capsense_fss_get_neighbours
+********************************************************************************
+* Summary:
+*  This function returns the loaded neighbour table and its number of
+*  entries, or NULL and 0 when FSS selects among groups.
+*
+*******************************************************************************/
+uint8_t capsense_fss_get_neighbours(const fss_bitmap_t **neighbours)
+{
+    *neighbours = fssNeighbours;
+    return (NULL != fssNeighbours) ? fssNeighbourCount : 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: fss_check_neighbours
+********************************************************************************
+* Summary:
+*  This function checks that a neighbour table only lists sensors of the
+*  table other than the sensor itself, each in both directions.
+*
+* Return:
+*  true if the table is valid, false otherwise.
+*
+*******************************************************************************/
+static bool fss_check_neighbours(const fss_bitmap_t *neighbours, uint8_t neighbourCount)
+{
+    if ((0 == neighbourCount) || (neighbourCount > sensorCount))
+    {
+        return false;
+    }
+
+    for (uint16_t sensor = 0; sensor < neighbourCount; sensor++)
+    {
+        for (uint16_t other = 0; other < (FSS_WORD_COUNT * FSS_WORD_BITS); other++)
+        {
+            bool listed = (0 != ((neighbours[sensor].word[other / FSS_WORD_BITS] >> (other % FSS_WORD_BITS)) &
+                                 WORD_LSB_MASK));
+
+            if (listed && ((other == sensor) || (other >= neighbourCount) ||
+                           (0 == ((neighbours[other].word[sensor / FSS_WORD_BITS] >> (sensor % FSS_WORD_BITS)) &
+                                  WORD_LSB_MASK))))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+
+/*******************************************************************************
+* Function Name: fss_build_masks
+********************************************************************************
+* Summary:
+*  This function checks a group table against the button sensors and derives
+*  its masks with the current FSS enable mask. With a neighbour table, the
+*  FSS buttons are the enabled buttons of that table instead.
+*
+* Return:
+*  true if the table is valid, false otherwise.
+*
+*******************************************************************************/
+static bool fss_build_masks(const fss_group_t *groups, uint8_t groupCount, fss_group_masks_t *masks)
+{
+    uint8_t groupOf[FSS_SENSOR_COUNT] = { 0 };
+    uint16_t nextSensor = 0;
+    uint8_t group;
+    uint8_t step;
+    uint16_t sensor;
+
+    for (group = 0; group < groupCount; group++)
+    {
+        uint16_t first = groups[group].firstSensor;
+        uint16_t last = first + groups[group].sensorCount - 1u;
+
+        if ((0 == groups[group].sensorCount) || (first < nextSensor) || (last >= sensorCount))
+        {
+            return false;
+        }
+        nextSensor = last + 1u;
+
+        masks->low[first / FSS_WORD_BITS] |= (fss_word_t)WORD_LSB_MASK << (first % FSS_WORD_BITS);
+        masks->top[last / FSS_WORD_BITS] |= (fss_word_t)WORD_LSB_MASK << (last % FSS_WORD_BITS);
+
+        for (sensor = first; sensor <= last; sensor++)
+        {
+            fss_word_t bit = (fss_word_t)WORD_LSB_MASK << (sensor % FSS_WORD_BITS);
+
+            groupOf[sensor] = group + 1u;
+            masks->member[sensor / FSS_WORD_BITS] |= bit & fssEnableMask.word[sensor / FSS_WORD_BITS];
+            if (sensor != last)
+            {
+                masks->body[sensor / FSS_WORD_BITS] |= bit;
+            }
+        }
+    }
+
+    for (sensor = 0; sensor < sensorCount; sensor++)
+    {
+        if (0 != groupOf[sensor])
+        {
+            for (step = 0; step < SPREAD_STEPS; step++)
+            {
+                uint16_t distance = 1u << step;
+
+                if ((((sensor % FSS_WORD_BITS) + distance) < FSS_WORD_BITS) &&
+                    ((sensor + distance) < sensorCount) && (groupOf[sensor + distance] == groupOf[sensor]))
+                {
+                    masks->join[step][sensor / FSS_WORD_BITS] |= (fss_word_t)WORD_LSB_MASK << (sensor % FSS_WORD_BITS);
+                }
+            }
+
+            if ((((sensor + 1u) % FSS_WORD_BITS) == 0) && ((sensor + 1u) < sensorCount) &&
+                (groupOf[sensor + 1u] == groupOf[sensor]))
+            {
+                masks->carry[sensor / FSS_WORD_BITS] = (fss_word_t)WORD_LSB_MASK << WORD_MSB_SHIFT;
+            }
+        }
+    }
+
+    /* With a neighbour table, the FSS buttons are the enabled buttons of the table */
+    if (NULL != fssNeighbours)
+    {
+        for (uint8_t word = 0; word < FSS_WORD_COUNT; word++)
+        {
+            masks->member[word] = ((word * FSS_WORD_BITS) < fssNeighbourCount) ?
+                                  (fssEnableMask.word[word] & fss_range_mask(word, 0, fssNeighbourCount - 1u)) : 0u;
+        }
+    }
+
+    return true;
+}
+
+
+/*******************************************************************************
+* Function Name: capsense_fss
+********************************************************************************
+* Summary:
+*  This function applies the FSS algorithm on the button sensors. When
+*  multiple sensors with FSS enabled are touched, the sensor touched first is 
+*  given the higher priority. capsense_fss_init() must have been called once
+*  after the CapSense initialization.
+*
+*  With FSS_DIFF_ARBITRATION, the difference counts are read in the same
+*  pass as the statuses. With FSS_ARRIVAL_ORDER, the buttons touched since
+*  the last frame are stamped with the arrival clock.
+*
+*  When the button status is the same as in the last frame, the FSS result
+*  is too, so the last result is reused. The result is kept in its own
+*  bitmap; with FSS_STATUS_WRITE_BACK, the sensors suppressed by FSS also
+*  have their status cleared, which is none at all while nothing is touched.
+*
+*******************************************************************************/
+void capsense_fss(void)
+{
+    bool unchanged = fssResultValid;
+    uint8_t sensor = 0;
+    uint8_t word;
+
+    /* Extracting current button statuses, a word at a time in a local
+     * variable: the status bytes may alias the global bitmap, so the
+     * compiler would otherwise store it back for every sensor
+     */
+    for (word = 0; word < FSS_WORD_COUNT; word++)
+    {
+        fss_word_t status = 0;
+
+        for (uint8_t bit = 0; (bit < FSS_WORD_BITS) && (sensor < sensorCount); bit++, sensor++)
+        {
+            status |= (fss_word_t)(buttonSensor[sensor]->status & CY_CAPSENSE_SNS_TOUCH_STATUS_MASK) << bit;
+#if (FSS_DIFF_ARBITRATION != 0u)
+            buttonDiff[sensor] = buttonSensor[sensor]->diff;
+#endif
+        }
+        currentButtonStatus.word[word] = status;
+    }
+
+    for (word = 0; word < FSS_WORD_COUNT; word++)
+    {
+        unchanged = unchanged && (currentButtonStatus.word[word] == rawButtonStatus.word[word]);
+    }
+
+    if (unchanged)
+    {
+        /* Reusing the FSS result of the last frame */
+        currentButtonStatus = previousButtonStatus;
+        for (word = 0; word < FSS_WORD_COUNT; word++)
+        {
+            changedButtonStatus.word[word] = 0;
+        }
+    }
+    else
+    {
+#if (FSS_ARRIVAL_ORDER != 0u)
+        fss_stamp_arrivals(&currentButtonStatus);
+#endif
+
+        /* Keeping the statuses before FSS for capsense_fss_get_raw_status() */
+        rawButtonStatus = currentButtonStatus;
+
+        /* Applying FSS algorithm */
+        if (NULL != fssNeighbours)
+        {
+            fss_algorithm_adjacent(&currentButtonStatus, &previousButtonStatus);
+        }
+        else
+        {
+#if (FSS_ARRIVAL_ORDER != 0u)
+            fss_algorithm_arrival(&currentButtonStatus, &previousButtonStatus);
+#else
+            fss_algorithm(&currentButtonStatus, &previousButtonStatus);
+#endif
+        }
+
+        for (word = 0; word < FSS_WORD_COUNT; word++)
+        {
+            changedButtonStatus.word[word] = currentButtonStatus.word[word] ^ previousButtonStatus.word[word];
+        }
+
+        /* Storing the current button statuses in previousButtonStatus for the next iteration */
+        previousButtonStatus = currentButtonStatus;
+        fssResultValid = true;
+    }
+
+#if (FSS_STATUS_WRITE_BACK != 0u)
+    /* Clearing the touch status of the buttons suppressed by FSS */
+    for (word = 0; word < FSS_WORD_COUNT; word++)
+    {
+        fss_word_t suppressed = rawButtonStatus.word[word] & ~currentButtonStatus.word[word];
+
+        while (0u != suppressed)
+        {
+            buttonSensor[(word * FSS_WORD_BITS) + fss_ctz(suppressed)]->status &=
+                (uint8_t)~CY_CAPSENSE_SNS_TOUCH_STATUS_MASK;
+            suppressed &= suppressed - 1u;
+        }
+    }
+#endif
+}
+
+
+/*******************************************************************************
+* Function Name: capsense_fss_get_winner
+********************************************************************************
+* Summary:
+*  This function returns the bit index of the lowest button selected by FSS
+*  in the last frame, or FSS_NO_WINNER when no FSS enabled button is active.
+*  With a single group and no neighbour table, this is the selected button.
+*
+*******************************************************************************/
+uint8_t capsense_fss_get_winner(void)
+{
+    for (uint8_t word = 0; word < FSS_WORD_COUNT; word++)
+    {
+        fss_word_t selected = previousButtonStatus.word[word] & fssGroups.member[word];
+
+        if (0 != selected)
+        {
+            return (uint8_t)((word * FSS_WORD_BITS) + fss_ctz(selected));
+        }
+    }
+
+    return FSS_NO_WINNER;
+}
+
+
+/*******************************************************************************
+* Function Name: capsense_fss_get_locked_mask
+********************************************************************************
+* Summary:
+*  This function gives the FSS enabled buttons that cannot be selected while
+*  the selection of the last frame is held: the other members of every group
+*  with all its selections taken (one button, or FSS_MAX_WINNERS with
+*  FSS_ARRIVAL_ORDER), or with a neighbour table, the neighbours of the
+*  selected buttons. Their status cannot change the FSS result until that
+*  button is released.
+*
+* Parameters:
+*  locked: where to write the buttons
+*
+*******************************************************************************/
+void capsense_fss_get_locked_mask(fss_bitmap_t *locked)
+{
+    uint8_t word;
+
+    for (word = 0; word < FSS_WORD_COUNT; word++)
+    {
+        locked->word[word] = 0;
+    }
+
+    if (NULL != fssNeighbours)
+    {
+        /* The neighbours of the selected buttons */
+        for (word = 0; word < FSS_WORD_COUNT; word++)
+        {
+            fss_word_t selected = previousButtonStatus.word[word] & fssGroups.member[word];
+
+            while (0u != selected)
+            {
+                const fss_bitmap_t *neighbours = &fssNeighbours[(word * FSS_WORD_BITS) + fss_ctz(selected)];
+
+                for (uint8_t other = 0; other < FSS_WORD_COUNT; other++)
+                {
+                    locked->word[other] |= neighbours->word[other];
+                }
+                selected &= selected - 1u;
+            }
+        }
+        for (word = 0; word < FSS_WORD_COUNT; word++)
+        {
+            locked->word[word] &= fssGroups.member[word] & ~previousButtonStatus.word[word];
+        }
+        return;
+    }
+
+    for (uint8_t group = 0; group < fssGroupCount; group++)
+    {
+        uint16_t first = fssGroupTable[group].firstSensor;
+        uint16_t last = first + fssGroupTable[group].sensorCount - 1u;
+        uint8_t winners = 0;
+
+        for (word = (uint8_t)(first / FSS_WORD_BITS); word <= (last / FSS_WORD_BITS); word++)
+        {
+            fss_word_t selected = previousButtonStatus.word[word] & fssGroups.member[word] &
+                                  fss_range_mask(word, first, last);
+
+            while (0u != selected)
+            {
+                winners++;
+                selected &= selected - 1u;
+            }
+        }
+
+        if (winners >= FSS_GROUP_WINNERS)
         {
-            for (uint8_t sensor_iter = 0; sensor_iter < cy_capsense_context.ptrWdConfig[widget].numSns; sensor_iter++)
+            for (word = (uint8_t)(first / FSS_WORD_BITS); word <= (last / FSS_WORD_BITS); word++)
             {
-                cy_capsense_context.ptrWdConfig[widget].ptrSnsContext[sensor_iter].status &= (CURRENTBUTTONSTATUS_LSB_MASK &
-                                                                                             currentButtonStatus);
-                currentButtonStatus >>= RIGHT_SHIFT_1BIT;
+                locked->word[word] |= fssGroups.member[word] & ~previousButtonStatus.word[word] &
+                                      fss_range_mask(word, first, last);
             }
         }
     }
 }
 
 
+/*******************************************************************************
+* Function Name: fss_range_mask
+********************************************************************************
+* Summary:
+*  Returns the bits of status word word that lie between sensors first and
+*  last, both included.
+*
+*******************************************************************************/
+static fss_word_t fss_range_mask(uint8_t word, uint16_t first, uint16_t last)
+{
+    fss_word_t mask = ~(fss_word_t)0;
+
+    if ((first / FSS_WORD_BITS) == word)
+    {
+        mask <<= first % FSS_WORD_BITS;
+    }
+    if ((last / FSS_WORD_BITS) == word)
+    {
+        mask &= ~(((~(fss_word_t)0) << (last % FSS_WORD_BITS)) << 1u);
+    }
+
+    return mask;
+}
+
+
+#if (FSS_ARRIVAL_ORDER == 0u)
 /*******************************************************************************
 * Function Name: fss_algorithm
 ********************************************************************************
 * Summary:
-*  This function implements the FSS algorithm
+*  This function implements the FSS algorithm on the button status in place,
+*  for all groups at once. In every group, the previously selected button
+*  stays selected while it is active; otherwise the lowest active button is
+*  selected. The groups are evaluated with word-wide arithmetic on the group
+*  masks, so the cost depends on the number of 32-bit words only, not on the
+*  number of groups or buttons:
+*  - Adding a group's body bits to its active bits carries into the group's
+*    top bit if, and only if, any of them is set.
+*  - Subtracting a group's low bit clears the lowest set bit of the group.
+*    Empty groups get their top bit set first, so the borrow never leaves
+*    the group.
+*  - Groups holding their previous selection are flagged at their top bit;
+*    the flags are spread down over the group in five shift steps, and the
+*    lowest active bit of those groups is dropped in favour of the held one.
+*  Carries, borrows and spreads continue across words for groups that do.
 *
 *******************************************************************************/
-static uint64_t fss_algorithm(uint64_t currentButtonStatus, uint64_t previousButtonStatus)
+static void fss_algorithm(fss_bitmap_t *currentButtonStatus, const fss_bitmap_t *previousButtonStatus)
 {
-    uint64_t activeFssButtons;
-    uint64_t reportedButtons;
+    fss_word_t lowestActive[FSS_WORD_COUNT];
+    fss_word_t heldTop[FSS_WORD_COUNT];
+#if (FSS_DIFF_ARBITRATION != 0u)
+    fss_word_t activeButtons[FSS_WORD_COUNT];
+    fss_word_t newSelections[FSS_WORD_COUNT];
+#endif
+    fss_word_t activeCarry = 0;
+    fss_word_t heldCarry = 0;
+    fss_word_t borrow = 0;
+    fss_word_t heldAbove = 0;
+    uint8_t word;
+    uint8_t step;
 
-    /* FSS algorithm is applied on all buttons */
-    uint64_t fssEnableMask = FSS_ENABLE_MASK;
+    /* Lowest word first: flag the groups with an active button and with a
+     * still active previous selection, and find the lowest active button of
+     * every group.
+     */
+    for (word = 0; word < FSS_WORD_COUNT; word++)
+    {
+        fss_word_t activeFssButtons = currentButtonStatus->word[word] & fssGroups.member[word];
+        fss_word_t heldButtons = previousButtonStatus->word[word] & activeFssButtons;
+        fss_word_t activeTop;
+        fss_word_t searched;
 
-    /* Assume initially that the previous FSS selection is still valid. */
-    reportedButtons = previousButtonStatus & fssEnableMask;
+        activeTop = (add_carry(activeFssButtons & fssGroups.body[word], fssGroups.body[word], &activeCarry) |
+                     activeFssButtons) & fssGroups.top[word];
+        heldTop[word] = (add_carry(heldButtons & fssGroups.body[word], fssGroups.body[word], &heldCarry) |
+                         heldButtons) & fssGroups.top[word];
 
-    /* Mask off the current FSS group. */
-    activeFssButtons = currentButtonStatus & fssEnableMask;
+#if (FSS_DIFF_ARBITRATION != 0u)
+        activeButtons[word] = activeFssButtons;
+#endif
+        searched = activeFssButtons | (fssGroups.top[word] & ~activeTop);
+        lowestActive[word] = searched & ~sub_borrow(searched, fssGroups.low[word], &borrow) & activeFssButtons;
+    }
 
-    /* This is non-zero only when a button which was ON previously is still ON,
-     * and is in the FSS group.
+    /* Highest word first: spread the held flags over their groups and merge
+     * the held selections, the new selections and the non-FSS buttons.
      */
-    if (0 == (activeFssButtons & previousButtonStatus))
+    for (word = FSS_WORD_COUNT; word-- > 0u; )
+    {
+        fss_word_t heldButtons = previousButtonStatus->word[word] & currentButtonStatus->word[word] &
+                                 fssGroups.member[word];
+        fss_word_t heldGroups = heldTop[word] | ((heldAbove << WORD_MSB_SHIFT) & fssGroups.carry[word]);
+
+        for (step = 0; step < SPREAD_STEPS; step++)
+        {
+            heldGroups |= (heldGroups >> (1u << step)) & fssGroups.join[step][word];
+        }
+        heldAbove = heldGroups & WORD_LSB_MASK;
+
+#if (FSS_DIFF_ARBITRATION != 0u)
+        newSelections[word] = lowestActive[word] & ~heldGroups;
+#endif
+
+        /* Combining the status of FSS enabled buttons with the non-FSS enabled buttons */
+        currentButtonStatus->word[word] = heldButtons | (lowestActive[word] & ~heldGroups) |
+                                          (currentButtonStatus->word[word] & ~fssGroups.member[word]);
+    }
+
+#if (FSS_DIFF_ARBITRATION != 0u)
+    fss_arbitrate(currentButtonStatus->word, activeButtons, newSelections);
+#endif
+}
+
+
+#if (FSS_DIFF_ARBITRATION != 0u)
+/*******************************************************************************
+* Function Name: fss_arbitrate
+********************************************************************************
+* Summary:
+*  This function moves every new group selection to the active button of the
+*  group with the highest difference count. A new selection is the lowest
+*  active button of its group, so only the active buttons from it up to the
+*  top of the group are compared. Groups holding their selection are left
+*  alone, so this only runs for the few frames where a selection changes.
+*
+* Parameters:
+*  status: the button status after FSS, updated in place
+*  active: the active FSS enabled buttons
+*  selected: the new selections, one per group at most
+*
+*******************************************************************************/
+static void fss_arbitrate(fss_word_t *status, const fss_word_t *active, const fss_word_t *selected)
+{
+    for (uint8_t word = 0; word < FSS_WORD_COUNT; word++)
     {
-        /* The previous FSS selection is no longer active.  Find a new FSS result. */
-        for (reportedButtons = 1;
-             (0 == (reportedButtons & activeFssButtons)) && (0 != reportedButtons);
-             reportedButtons <<= 1)
+        fss_word_t pending = selected[word];
+
+        while (0u != pending)
         {
-            /* Do nothing since the loop termination conditions will result in the
-             * correct resulting value of reportedButtons.
-             */
+            uint8_t first = (uint8_t)((word * FSS_WORD_BITS) + fss_ctz(pending));
+            uint8_t strongest = first;
+            uint8_t other = word;
+            fss_word_t fromFirst = (~(fss_word_t)0) << (first % FSS_WORD_BITS);
+            fss_word_t above = fromFirst << 1u;
+            fss_word_t top = fssGroups.top[word] & fromFirst;
+            fss_word_t competing;
+
+            /* The top of the group is the first top bit from the selection on */
+            while (0u == top)
+            {
+                other++;
+                top = fssGroups.top[other];
+            }
+            top &= (0u - top);
+
+            for (uint8_t scan = word; scan <= other; scan++)
+            {
+                competing = active[scan] & ((scan == word) ? above : ~(fss_word_t)0) &
+                            ((scan == other) ? (top | (top - 1u)) : ~(fss_word_t)0);
+
+                while (0u != competing)
+                {
+                    uint8_t sensor = (uint8_t)((scan * FSS_WORD_BITS) + fss_ctz(competing));
+
+                    if (buttonDiff[sensor] > buttonDiff[strongest])
+                    {
+                        strongest = sensor;
+                    }
+                    competing &= competing - 1u;
+                }
+            }
+
+            if (strongest != first)
+            {
+                status[word] &= ~((fss_word_t)WORD_LSB_MASK << (first % FSS_WORD_BITS));
+                status[strongest / FSS_WORD_BITS] |= (fss_word_t)WORD_LSB_MASK << (strongest % FSS_WORD_BITS);
+            }
+            pending &= pending - 1u;
         }
     }
+}
+#endif
+#endif
+
+
+#if (FSS_ARRIVAL_ORDER != 0u)
+/*******************************************************************************
+* Function Name: fss_stamp_arrivals
+********************************************************************************
+* Summary:
+*  This function stamps the buttons that are active in status but were not
+*  in the last changed frame with the arrival clock, and advances the clock
+*  if there is any. Buttons touched in the same frame share a stamp.
+*
+*******************************************************************************/
+static void fss_stamp_arrivals(const fss_bitmap_t *status)
+{
+    bool arrived = false;
+
+    for (uint8_t word = 0; word < FSS_WORD_COUNT; word++)
+    {
+        fss_word_t touched = status->word[word] & ~rawButtonStatus.word[word];
+
+        arrived = arrived || (0u != touched);
+        while (0u != touched)
+        {
+            fssArrival[(word * FSS_WORD_BITS) + fss_ctz(touched)] = fssArrivalClock;
+            touched &= touched - 1u;
+        }
+    }
+
+    if (arrived)
+    {
+        fssArrivalClock++;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: fss_algorithm_arrival
+********************************************************************************
+* Summary:
+*  This function implements the FSS algorithm with arrival order on the
+*  button status in place. In every group, the previously selected buttons
+*  stay selected while they are active, and the selections they leave free,
+*  up to FSS_MAX_WINNERS, go to the active buttons touched first; buttons
+*  touched in the same frame are taken lowest first or, with
+*  FSS_DIFF_ARBITRATION, strongest first. The other buttons of the group are
+*  suppressed. A full group takes no new selection, so the result is the
+*  same when the status does not change, which capsense_fss() relies on to
+*  reuse it.
+*
+*******************************************************************************/
+static void fss_algorithm_arrival(fss_bitmap_t *currentButtonStatus, const fss_bitmap_t *previousButtonStatus)
+{
+    fss_word_t selected[FSS_WORD_COUNT];
+    fss_word_t candidates[FSS_WORD_COUNT];
+    uint8_t sensor;
+    uint8_t word;
+
+    for (word = 0; word < FSS_WORD_COUNT; word++)
+    {
+        selected[word] = previousButtonStatus->word[word] & currentButtonStatus->word[word] &
+                         fssGroups.member[word];
+        candidates[word] = 0;
+    }
+
+    for (uint8_t group = 0; group < fssGroupCount; group++)
+    {
+        uint16_t first = fssGroupTable[group].firstSensor;
+        uint16_t last = first + fssGroupTable[group].sensorCount - 1u;
+        uint8_t winners = 0;
+
+        /* Counting the held selections and collecting the other active buttons */
+        for (word = (uint8_t)(first / FSS_WORD_BITS); word <= (last / FSS_WORD_BITS); word++)
+        {
+            fss_word_t range = fss_range_mask(word, first, last);
+            fss_word_t held = selected[word] & range;
+
+            candidates[word] = currentButtonStatus->word[word] & fssGroups.member[word] &
+                               ~selected[word] & range;
+            while (0u != held)
+            {
+                winners++;
+                held &= held - 1u;
+            }
+        }
+
+        while ((winners < FSS_GROUP_WINNERS) && (FSS_NO_WINNER != (sensor = fss_next_candidate(candidates))))
+        {
+            fss_word_t bit = (fss_word_t)WORD_LSB_MASK << (sensor % FSS_WORD_BITS);
+
+            selected[sensor / FSS_WORD_BITS] |= bit;
+            candidates[sensor / FSS_WORD_BITS] &= ~bit;
+            winners++;
+        }
+
+        for (word = (uint8_t)(first / FSS_WORD_BITS); word <= (last / FSS_WORD_BITS); word++)
+        {
+            candidates[word] = 0;
+        }
+    }
+
+    for (word = 0; word < FSS_WORD_COUNT; word++)
+    {
+        /* Combining the status of FSS enabled buttons with the non-FSS enabled buttons */
+        currentButtonStatus->word[word] = selected[word] |
+                                          (currentButtonStatus->word[word] & ~fssGroups.member[word]);
+    }
+}
+#endif
+
+
+/*******************************************************************************
+* Function Name: fss_algorithm_adjacent
+********************************************************************************
+* Summary:
+*  This function implements the FSS algorithm with the neighbour table on
+*  the button status in place. A previously selected button stays selected
+*  while it is active. Any other active button is selected unless it is the
+*  neighbour of a selected button; they are taken lowest first or, with
+*  FSS_DIFF_ARBITRATION, strongest first, and with FSS_ARRIVAL_ORDER, the
+*  buttons touched first go first. Each
+*  selected button removes its neighbours from all the remaining buttons at
+*  once, a word at a time, so the cost grows with the number of selected
+*  buttons and words, not with the number of buttons or neighbours. The
+*  result is the same when the status does not change, which capsense_fss()
+*  relies on to reuse it.
+*
+*******************************************************************************/
+static void fss_algorithm_adjacent(fss_bitmap_t *currentButtonStatus, const fss_bitmap_t *previousButtonStatus)
+{
+    fss_word_t heldButtons[FSS_WORD_COUNT];
+    fss_word_t candidates[FSS_WORD_COUNT];
+    fss_word_t suppressed[FSS_WORD_COUNT] = { 0 };
+    fss_word_t selected[FSS_WORD_COUNT];
+    uint8_t sensor;
+    uint8_t word;
+    uint8_t other;
+
+    /* Suppressing the neighbours of the held selections */
+    for (word = 0; word < FSS_WORD_COUNT; word++)
+    {
+        fss_word_t held = previousButtonStatus->word[word] & currentButtonStatus->word[word] &
+                          fssGroups.member[word];
+
+        heldButtons[word] = held;
+        while (0u != held)
+        {
+            const fss_bitmap_t *neighbours = &fssNeighbours[(word * FSS_WORD_BITS) + fss_ctz(held)];
+
+            for (other = 0; other < FSS_WORD_COUNT; other++)
+            {
+                suppressed[other] |= neighbours->word[other];
+            }
+            held &= held - 1u;
+        }
+    }
+
+    for (word = 0; word < FSS_WORD_COUNT; word++)
+    {
+        candidates[word] = currentButtonStatus->word[word] & fssGroups.member[word] &
+                           ~heldButtons[word] & ~suppressed[word];
+    }
+
+    /* Selecting the next remaining button and suppressing its neighbours
+     * until none is left
+     */
+    for (word = 0; word < FSS_WORD_COUNT; word++)
+    {
+        selected[word] = 0;
+    }
+    while (FSS_NO_WINNER != (sensor = fss_next_candidate(candidates)))
+    {
+        const fss_bitmap_t *neighbours = &fssNeighbours[sensor];
+
+        word = sensor / FSS_WORD_BITS;
+        selected[word] |= (fss_word_t)WORD_LSB_MASK << (sensor % FSS_WORD_BITS);
+        candidates[word] &= ~((fss_word_t)WORD_LSB_MASK << (sensor % FSS_WORD_BITS));
+        for (other = 0; other < FSS_WORD_COUNT; other++)
+        {
+            candidates[other] &= ~neighbours->word[other];
+        }
+    }
+
+    for (word = 0; word < FSS_WORD_COUNT; word++)
+    {
+        /* Combining the status of FSS enabled buttons with the non-FSS enabled buttons */
+        currentButtonStatus->word[word] = heldButtons[word] | selected[word] |
+                                          (currentButtonStatus->word[word] & ~fssGroups.member[word]);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: fss_next_candidate
+********************************************************************************
+* Summary:
+*  Returns the candidate button to select first: the lowest one or, with
+*  FSS_ARRIVAL_ORDER or FSS_DIFF_ARBITRATION, the first in the order of
+*  fss_precedes().
+*
+* Return:
+*  The bit index of the button, or FSS_NO_WINNER if there is no candidate.
+*
+*******************************************************************************/
+static uint8_t fss_next_candidate(const fss_word_t *candidates)
+{
+    uint8_t next = FSS_NO_WINNER;
+
+    for (uint8_t word = 0; word < FSS_WORD_COUNT; word++)
+    {
+#if ((FSS_DIFF_ARBITRATION != 0u) || (FSS_ARRIVAL_ORDER != 0u))
+        fss_word_t remaining = candidates[word];
+
+        while (0u != remaining)
+        {
+            uint8_t sensor = (uint8_t)((word * FSS_WORD_BITS) + fss_ctz(remaining));
+
+            if ((FSS_NO_WINNER == next) || fss_precedes(sensor, next))
+            {
+                next = sensor;
+            }
+            remaining &= remaining - 1u;
+        }
+#else
+        if (0u != candidates[word])
+        {
+            return (uint8_t)((word * FSS_WORD_BITS) + fss_ctz(candidates[word]));
+        }
+#endif
+    }
+
+    return next;
+}
+
+
+#if ((FSS_DIFF_ARBITRATION != 0u) || (FSS_ARRIVAL_ORDER != 0u))
+/*******************************************************************************
+* Function Name: fss_precedes
+********************************************************************************
+* Summary:
+*  Returns true if sensor is to be selected before other: with
+*  FSS_ARRIVAL_ORDER, the button touched first goes first, and with
+*  FSS_DIFF_ARBITRATION, the one with the higher difference count goes
+*  first among those touched in the same frame.
+*
+*******************************************************************************/
+static bool fss_precedes(uint8_t sensor, uint8_t other)
+{
+#if (FSS_ARRIVAL_ORDER != 0u)
+    uint16_t age = (uint16_t)(fssArrivalClock - fssArrival[sensor]);
+    uint16_t otherAge = (uint16_t)(fssArrivalClock - fssArrival[other]);
+
+    if (age != otherAge)
+    {
+        return (age > otherAge);
+    }
+#endif
 
-    /* Combining the status of FSS enabled buttons with the non-FSS enabled buttons */
-    return(reportedButtons | (currentButtonStatus & ~fssEnableMask));
+#if (FSS_DIFF_ARBITRATION != 0u)
+    return (buttonDiff[sensor] > buttonDiff[other]);
+#else
+    return false;
+#endif
 }
+#endif
 
 
 /* [] END OF FILE */
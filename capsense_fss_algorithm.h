@@ -39,16 +39,192 @@
 * so agrees to indemnify Cypress against all liability.
 *******************************************************************************/
 
+#ifndef CAPSENSE_FSS_ALGORITHM_H
+#define CAPSENSE_FSS_ALGORITHM_H
+
 /*******************************************************************************
  * Include header files
  ******************************************************************************/
+#include <stdbool.h>
 #include "cycfg_capsense_defines.h"
 #include "cycfg_capsense.h"
+#ifdef FSS_GENERATED_TABLES
+/* FSS_SENSOR_COUNT, the button sensor table and the FSS and LED tables,
+ * generated from the design by scripts/fss_tables.py. Refer README.md.
+ */
+#include "cycfg_fss.h"
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Maximum number of button sensors. The generated configuration only gives
+ * the total sensor count, which is an upper bound. The number of status
+ * words is derived from it at compile time; with one word, the compiler
+ * drops all carries between words. Define FSS_SENSOR_COUNT to the number of
+ * button sensors when sliders or other widgets push the total over a
+ * multiple of 32. Button sensors beyond it are ignored by FSS.
+ */
+#ifndef FSS_SENSOR_COUNT
+#define FSS_SENSOR_COUNT               (CY_CAPSENSE_SENSOR_COUNT)
+#endif
+
+/* Button sensor indices and counts are kept in single bytes */
+#if (FSS_SENSOR_COUNT > 255u)
+#error "FSS_SENSOR_COUNT must be at most 255"
+#endif
+
+/* The button status is kept in 32-bit words, the native word of Cortex-M0 */
+#define FSS_WORD_BITS                  (32u)
+#define FSS_WORD_COUNT                 ((FSS_SENSOR_COUNT + FSS_WORD_BITS - 1u) / FSS_WORD_BITS)
+
+/* Size of the group table kept by capsense_fss_set_groups() */
+#ifndef FSS_MAX_GROUP_COUNT
+#define FSS_MAX_GROUP_COUNT            (8u)
+#endif
+
+/* Set FSS_DIFF_ARBITRATION to 1 to select, among the buttons competing for
+ * a new selection in the same frame, the one with the highest difference
+ * count rather than the lowest one. The flanking finger then loses to the
+ * intended key even when both cross the touch threshold in the same frame,
+ * which allows a lower debounce count. Equal counts go to the lowest button.
+ */
+#ifndef FSS_DIFF_ARBITRATION
+#define FSS_DIFF_ARBITRATION           (0u)
+#endif
+
+/* Set FSS_ARRIVAL_ORDER to 1 to keep up to FSS_MAX_WINNERS buttons selected
+ * in every group, so that chords can be played within a group, and to give
+ * a free selection to the active button that was touched first rather than
+ * to the lowest one. The other buttons of a full group are still
+ * suppressed. With a neighbour table, new selections are taken in the same
+ * order.
+ */
+#ifndef FSS_ARRIVAL_ORDER
+#define FSS_ARRIVAL_ORDER              (0u)
+#endif
+
+/* Number of buttons selected at once in a group with FSS_ARRIVAL_ORDER */
+#ifndef FSS_MAX_WINNERS
+#define FSS_MAX_WINNERS                (2u)
+#endif
+
+/* Set FSS_STATUS_WRITE_BACK to 0 to leave the sensor status of the
+ * CAPSENSE context as the middleware computed it, so that the tuner and the
+ * middleware see every touch, and read the FSS result only from the
+ * bitmaps below. With 1, the default, the touch status of the buttons
+ * suppressed by FSS is also cleared in the context every frame. Focused
+ * scanning (CAPSENSE_FRAME_FOCUS) needs it.
+ */
+#ifndef FSS_STATUS_WRITE_BACK
+#define FSS_STATUS_WRITE_BACK          (1u)
+#endif
+
+/* Returned by capsense_fss_get_winner() when no FSS button is selected */
+#define FSS_NO_WINNER                  (0xFFu)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef uint32_t fss_word_t;
+
+/* One bit per button sensor, bit N of the bitmap being bit (N % 32) of
+ * word (N / 32).
+ */
+typedef struct
+{
+    fss_word_t word[FSS_WORD_COUNT];
+} fss_bitmap_t;
+
+/* An FSS group: a run of consecutive button sensors with its own selection */
+typedef struct
+{
+    uint8_t firstSensor;    /* Bit index of the first button sensor */
+    uint8_t sensorCount;    /* Number of button sensors in the group */
+} fss_group_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Button status of the last frame after FSS, before FSS, and the buttons
+ * whose status after FSS changed in it. Read them with the functions below.
+ */
+extern fss_bitmap_t previousButtonStatus;
+extern fss_bitmap_t rawButtonStatus;
+extern fss_bitmap_t changedButtonStatus;
 
 /*******************************************************************************
 * Function Prototypes
 *******************************************************************************/
+void capsense_fss_init(void);
+uint8_t capsense_fss_get_sensor_count(void);
+bool capsense_fss_set_groups(const fss_group_t *groups, uint8_t groupCount);
+uint8_t capsense_fss_get_groups(const fss_group_t **groups);
+bool capsense_fss_set_neighbours(const fss_bitmap_t *neighbours, uint8_t neighbourCount);
+uint8_t capsense_fss_get_neighbours(const fss_bitmap_t **neighbours);
+void capsense_fss_set_enable_mask(const fss_bitmap_t *mask);
+const fss_bitmap_t *capsense_fss_get_enable_mask(void);
 void capsense_fss(void);
+uint8_t capsense_fss_get_winner(void);
+void capsense_fss_get_locked_mask(fss_bitmap_t *locked);
+
+
+/*******************************************************************************
+* Function Name: capsense_fss_get_status
+********************************************************************************
+* Summary:
+*  This function returns the button status of the last frame after FSS.
+*
+*******************************************************************************/
+static inline const fss_bitmap_t *capsense_fss_get_status(void)
+{
+    return &previousButtonStatus;
+}
+
+
+/*******************************************************************************
+* Function Name: capsense_fss_get_raw_status
+********************************************************************************
+* Summary:
+*  This function returns the button status of the last frame before FSS.
+*
+*******************************************************************************/
+static inline const fss_bitmap_t *capsense_fss_get_raw_status(void)
+{
+    return &rawButtonStatus;
+}
+
+
+/*******************************************************************************
+* Function Name: capsense_fss_get_changed
+********************************************************************************
+* Summary:
+*  This function returns the buttons whose status after FSS changed in the
+*  last frame, none when the button status did not change.
+*
+*******************************************************************************/
+static inline const fss_bitmap_t *capsense_fss_get_changed(void)
+{
+    return &changedButtonStatus;
+}
+
+
+/*******************************************************************************
+* Function Name: capsense_fss_is_active
+********************************************************************************
+* Summary:
+*  This function returns whether a button sensor, given by its bit index, is
+*  active after FSS in the last frame. An index beyond FSS_SENSOR_COUNT is
+*  never active.
+*
+*******************************************************************************/
+static inline bool capsense_fss_is_active(uint8_t sensor)
+{
+    return (sensor < FSS_SENSOR_COUNT) &&
+           (0u != (previousButtonStatus.word[sensor / FSS_WORD_BITS] & ((fss_word_t)1u << (sensor % FSS_WORD_BITS))));
+}
+
+#endif /* CAPSENSE_FSS_ALGORITHM_H */
 
 
 /* [] END OF FILE */
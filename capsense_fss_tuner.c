@@ -0,0 +1,192 @@
+/******************************************************************************
+* File Name: capsense_fss_tuner.c
+*
+* Description: This is the source code for the FSS control and status block
+*              exposed over EZI2C
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "capsense_fss_tuner.h"
+#include "cy_pdl.h"
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+capsense_fss_tuner_t capsense_fss_tuner;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void fss_tuner_read_config(void);
+static void fss_tuner_apply(void);
+
+/*******************************************************************************
+* Function Name: capsense_fss_tuner_init
+********************************************************************************
+* Summary:
+*  This function fills the FSS control block with the configuration loaded
+*  by capsense_fss_init(), which must have been called first, and empties
+*  the touch event ring and the trace capture.
+*
+*******************************************************************************/
+void capsense_fss_tuner_init(void)
+{
+    fss_tuner_read_config();
+
+    capsense_fss_tuner.command = FSS_TUNER_CMD_NONE;
+    capsense_fss_tuner.result = FSS_TUNER_RESULT_OK;
+    capsense_fss_tuner.sensorCount = capsense_fss_get_sensor_count();
+    capsense_fss_tuner.winner = FSS_NO_WINNER;
+    capsense_fss_tuner.statusSequenceEnd = capsense_fss_tuner.statusSequence;
+
+    capsense_event_init(&capsense_fss_tuner.events, &capsense_fss_tuner.eventTail);
+
+#if (CAPSENSE_CAPTURE_ENABLE != 0u)
+    capsense_capture_init(&capsense_fss_tuner.capture, &capsense_fss_tuner.captureTail);
+#endif
+
+#if (CAPSENSE_PROFILE_ENABLE != 0u)
+    capsense_profile_init(&capsense_fss_tuner.profile);
+#endif
+}
+
+
+/*******************************************************************************
+* Function Name: capsense_fss_tuner_update
+********************************************************************************
+* Summary:
+*  This function executes a pending host command and publishes the button
+*  status of the frame. Call it once per frame after capsense_fss(). The
+*  EZI2C interrupt can read the block between any two stores, so the
+*  sequence bytes frame the status.
+*
+*******************************************************************************/
+void capsense_fss_tuner_update(void)
+{
+    uint8_t sequence = (uint8_t)(capsense_fss_tuner.statusSequence + 1u);
+
+    if (FSS_TUNER_CMD_APPLY == capsense_fss_tuner.command)
+    {
+        fss_tuner_apply();
+    }
+#if (CAPSENSE_PROFILE_ENABLE != 0u)
+    else if (FSS_TUNER_CMD_PROFILE_RESET == capsense_fss_tuner.command)
+    {
+        capsense_profile_reset();
+        capsense_fss_tuner.result = FSS_TUNER_RESULT_OK;
+        capsense_fss_tuner.command = FSS_TUNER_CMD_NONE;
+    }
+#endif
+    else if (FSS_TUNER_CMD_NONE != capsense_fss_tuner.command)
+    {
+        capsense_fss_tuner.result = FSS_TUNER_RESULT_INVALID;
+        capsense_fss_tuner.command = FSS_TUNER_CMD_NONE;
+    }
+
+    capsense_fss_tuner.statusSequenceEnd = sequence;
+    __DMB();
+
+    capsense_fss_tuner.rawStatus = *capsense_fss_get_raw_status();
+    capsense_fss_tuner.fssStatus = *capsense_fss_get_status();
+    capsense_fss_tuner.winner = capsense_fss_get_winner();
+
+    __DMB();
+    capsense_fss_tuner.statusSequence = sequence;
+}
+
+
+/*******************************************************************************
+* Function Name: fss_tuner_apply
+********************************************************************************
+* Summary:
+*  This function loads the enable mask and the group table written by the
+*  host. Both are loaded or, if the group table is invalid, neither is.
+*
+*******************************************************************************/
+static void fss_tuner_apply(void)
+{
+    fss_bitmap_t previousMask = *capsense_fss_get_enable_mask();
+
+    capsense_fss_set_enable_mask(&capsense_fss_tuner.enableMask);
+
+    if (capsense_fss_set_groups(capsense_fss_tuner.groups, capsense_fss_tuner.groupCount))
+    {
+        capsense_fss_tuner.result = FSS_TUNER_RESULT_OK;
+    }
+    else
+    {
+        capsense_fss_set_enable_mask(&previousMask);
+        capsense_fss_tuner.result = FSS_TUNER_RESULT_INVALID;
+    }
+
+    /* Reading back the configuration in use */
+    fss_tuner_read_config();
+    capsense_fss_tuner.command = FSS_TUNER_CMD_NONE;
+}
+
+
+/*******************************************************************************
+* Function Name: fss_tuner_read_config
+********************************************************************************
+* Summary:
+*  This function copies the FSS configuration in use to the control block.
+*
+*******************************************************************************/
+static void fss_tuner_read_config(void)
+{
+    const fss_group_t *groups;
+    uint8_t groupCount = capsense_fss_get_groups(&groups);
+    uint8_t group;
+
+    capsense_fss_tuner.enableMask = *capsense_fss_get_enable_mask();
+
+    for (group = 0; group < groupCount; group++)
+    {
+        capsense_fss_tuner.groups[group] = groups[group];
+    }
+    for (; group < FSS_MAX_GROUP_COUNT; group++)
+    {
+        capsense_fss_tuner.groups[group].firstSensor = 0;
+        capsense_fss_tuner.groups[group].sensorCount = 0;
+    }
+    capsense_fss_tuner.groupCount = groupCount;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,127 @@
+/******************************************************************************
+* File Name: capsense_fss_tuner.h
+*
+* Description: This file contains the layout and the function prototypes of
+*              the FSS control and status block exposed over EZI2C
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CAPSENSE_FSS_TUNER_H
+#define CAPSENSE_FSS_TUNER_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stddef.h>
+#include "capsense_capture.h"
+#include "capsense_event.h"
+#include "capsense_fss_algorithm.h"
+#include "capsense_profile.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Values of capsense_fss_tuner.command */
+#define FSS_TUNER_CMD_NONE             (0u)
+#define FSS_TUNER_CMD_APPLY            (1u)
+#define FSS_TUNER_CMD_PROFILE_RESET    (2u)
+
+/* Values of capsense_fss_tuner.result */
+#define FSS_TUNER_RESULT_OK            (0u)
+#define FSS_TUNER_RESULT_INVALID       (1u)
+
+/* The host can write the block up to this offset; the rest is read only */
+#define FSS_TUNER_RW_BOUNDARY          (offsetof(capsense_fss_tuner_t, result))
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* FSS control and status block. The host writes enableMask, groups and
+ * groupCount, then FSS_TUNER_CMD_APPLY to command. The firmware applies them
+ * at the end of the next frame, writes back the configuration in use, sets
+ * result and clears command. The status fields, from statusSequence to
+ * statusSequenceEnd, are refreshed every frame and framed as in the status
+ * map: the host reads them in one transaction and keeps the read only if
+ * both sequence bytes are equal.
+ * With the profiler, FSS_TUNER_CMD_PROFILE_RESET clears the stage timings.
+ * To drain the touch events, the host reads events.head and the events from
+ * eventTail up to it, then writes the new eventTail. The trace capture is
+ * drained the same way with capture.head and captureTail.
+ */
+typedef struct
+{
+    /* Read and write */
+    fss_bitmap_t enableMask;                    /* FSS enable mask */
+    fss_group_t groups[FSS_MAX_GROUP_COUNT];    /* FSS group table */
+    uint8_t groupCount;                         /* Number of entries in groups */
+    volatile uint8_t command;                   /* FSS_TUNER_CMD_xxx */
+    volatile uint8_t eventTail;                 /* Read index of events, refer capsense_event.h */
+#if (CAPSENSE_CAPTURE_ENABLE != 0u)
+    volatile uint16_t captureTail;              /* Read index of capture, refer capsense_capture.h */
+#endif
+
+    /* Read only */
+    uint8_t result;                             /* FSS_TUNER_RESULT_xxx of the last command */
+    uint8_t sensorCount;                        /* Number of button sensors */
+    uint8_t statusSequence;                     /* Written last */
+    uint8_t winner;                             /* capsense_fss_get_winner() */
+    fss_bitmap_t rawStatus;                     /* Button status before FSS */
+    fss_bitmap_t fssStatus;                     /* Button status after FSS */
+    uint8_t statusSequenceEnd;                  /* Written first */
+    capsense_event_ring_t events;               /* Touch events */
+#if (CAPSENSE_CAPTURE_ENABLE != 0u)
+    capsense_capture_ring_t capture;            /* Touch trace capture */
+#endif
+#if (CAPSENSE_PROFILE_ENABLE != 0u)
+    capsense_profile_t profile;                 /* Stage timings, refer capsense_profile.h */
+#endif
+} capsense_fss_tuner_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern capsense_fss_tuner_t capsense_fss_tuner;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void capsense_fss_tuner_init(void);
+void capsense_fss_tuner_update(void);
+
+#endif /* CAPSENSE_FSS_TUNER_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,184 @@
+/******************************************************************************
+* File Name: capsense_idle.c
+*
+* Description: This is the source code for the Deep Sleep interval of the idle
+*              mode. The watchdog timer, clocked by the ILO, wakes the CPU for the
+*              next wake-up scan.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdbool.h>
+#include "capsense_idle.h"
+#include "cybsp.h"
+#include "cycfg_capsense.h"
+#include "cy_pdl.h"
+
+#if (CAPSENSE_IDLE_ENABLE != 0u)
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define IDLE_WDT_INTR_PRIORITY         (3u)
+#define IDLE_WDT_COUNT_MASK            (0xFFFFu)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Set by the watchdog interrupt at the end of the interval */
+static volatile bool intervalDone;
+
+/* Nominal CPU clock ticks spent in Deep Sleep, modulo 2^32 */
+static uint32_t sleepTicks;
+
+/* Holds Deep Sleep off while a scan runs */
+static cy_stc_syspm_callback_params_t capsenseDeepSleepParams =
+{
+    .base = CYBSP_CSD_HW,
+    .context = &cy_capsense_context,
+};
+
+static cy_stc_syspm_callback_t capsenseDeepSleepCallback =
+{
+    .callback = Cy_CapSense_DeepSleepCallback,
+    .type = CY_SYSPM_DEEPSLEEP,
+    .callbackParams = &capsenseDeepSleepParams,
+};
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void capsense_idle_wdt_isr(void);
+
+/*******************************************************************************
+* Function Name: capsense_idle_init
+********************************************************************************
+* Summary:
+*  This function registers the CAPSENSE Deep Sleep callback and the watchdog
+*  interrupt. The watchdog timer only runs during the idle intervals.
+*
+*******************************************************************************/
+void capsense_idle_init(void)
+{
+    const cy_stc_sysint_t wdt_interrupt_config =
+    {
+        .intrSrc = srss_interrupt_wdt_IRQn,
+        .intrPriority = IDLE_WDT_INTR_PRIORITY,
+    };
+
+    (void)Cy_SysPm_RegisterCallback(&capsenseDeepSleepCallback);
+
+    Cy_WDT_Disable();
+    Cy_WDT_MaskInterrupt();
+    Cy_SysInt_Init(&wdt_interrupt_config, capsense_idle_wdt_isr);
+    NVIC_EnableIRQ(wdt_interrupt_config.intrSrc);
+}
+
+
+/*******************************************************************************
+* Function Name: capsense_idle_sleep
+********************************************************************************
+* Summary:
+*  This function puts the CPU in Deep Sleep for CAPSENSE_IDLE_INTERVAL_MS.
+*  Other interrupts, such as an EZI2C address match, wake the CPU as well
+*  and it goes back to Deep Sleep. No scan may be running.
+*
+*******************************************************************************/
+void capsense_idle_sleep(void)
+{
+    intervalDone = false;
+
+    Cy_WDT_SetMatch((Cy_WDT_GetCount() + CAPSENSE_IDLE_INTERVAL_TICKS) & IDLE_WDT_COUNT_MASK);
+    Cy_WDT_ClearInterrupt();
+    Cy_WDT_UnmaskInterrupt();
+    Cy_WDT_Enable();
+
+    __disable_irq();
+    while (!intervalDone)
+    {
+        (void)Cy_SysPm_CpuEnterDeepSleep();
+
+        /* Taking the interrupt that ended the sleep */
+        __enable_irq();
+        __disable_irq();
+    }
+    __enable_irq();
+
+    /* Left running, the watchdog would reset the device after three
+     * unserviced matches
+     */
+    Cy_WDT_MaskInterrupt();
+    Cy_WDT_Disable();
+
+    sleepTicks += CAPSENSE_IDLE_INTERVAL_MS * (SystemCoreClock / 1000u);
+}
+
+
+/*******************************************************************************
+* Function Name: capsense_idle_get_sleep_ticks
+********************************************************************************
+* Summary:
+*  This function returns the time spent in Deep Sleep, in CPU clock ticks,
+*  modulo 2^32. SysTick stops in Deep Sleep, so a time base counting it adds
+*  this time. It is the nominal interval times the number of intervals, so
+*  it is only as accurate as the ILO.
+*
+*******************************************************************************/
+uint32_t capsense_idle_get_sleep_ticks(void)
+{
+    return sleepTicks;
+}
+
+
+/*******************************************************************************
+* Function Name: capsense_idle_wdt_isr
+********************************************************************************
+* Summary:
+*  Watchdog match interrupt: ends the idle interval.
+*
+*******************************************************************************/
+static void capsense_idle_wdt_isr(void)
+{
+    Cy_WDT_ClearInterrupt();
+    intervalDone = true;
+}
+
+#endif /* CAPSENSE_IDLE_ENABLE */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,98 @@
+/******************************************************************************
+* File Name: capsense_idle.h
+*
+* Description: This file contains the settings and the function prototypes of
+*              the low-power idle mode of the frame loop
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CAPSENSE_IDLE_H
+#define CAPSENSE_IDLE_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Set to 1 to drop to slow wake-up scans with Deep Sleep in between once no
+ * widget has been active for CAPSENSE_IDLE_TIMEOUT frames. Refer README.md.
+ */
+#ifndef CAPSENSE_IDLE_ENABLE
+#define CAPSENSE_IDLE_ENABLE           (0u)
+#endif
+
+/* Frames without an active widget before entering idle mode */
+#ifndef CAPSENSE_IDLE_TIMEOUT
+#define CAPSENSE_IDLE_TIMEOUT          (200u)
+#endif
+
+/* Time between two wake-up scans, in ms, measured on the ILO */
+#ifndef CAPSENSE_IDLE_INTERVAL_MS
+#define CAPSENSE_IDLE_INTERVAL_MS      (100u)
+#endif
+
+/* Define CAPSENSE_IDLE_WAKE_WIDGET to the index of a widget, such as a
+ * proximity sensor ganged with all the buttons in the CAPSENSE Configurator,
+ * to scan only this widget when idle. Full-rate frames then leave it out. By
+ * default, all widgets are scanned.
+ */
+
+/* Nominal ILO frequency clocking the watchdog timer */
+#define CAPSENSE_IDLE_ILO_HZ           (40000u)
+
+#define CAPSENSE_IDLE_INTERVAL_TICKS   ((CAPSENSE_IDLE_INTERVAL_MS * CAPSENSE_IDLE_ILO_HZ) / 1000u)
+
+#if (CAPSENSE_IDLE_ENABLE != 0u) && \
+    ((CAPSENSE_IDLE_INTERVAL_TICKS == 0u) || (CAPSENSE_IDLE_INTERVAL_TICKS > 0xFFFFu))
+#error "CAPSENSE_IDLE_INTERVAL_MS must fit the 16-bit watchdog counter"
+#endif
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+#if (CAPSENSE_IDLE_ENABLE != 0u)
+void capsense_idle_init(void);
+void capsense_idle_sleep(void);
+uint32_t capsense_idle_get_sleep_ticks(void);
+#endif
+
+#endif /* CAPSENSE_IDLE_H */
+
+
+/* [] END OF FILE */
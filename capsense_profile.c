@@ -0,0 +1,216 @@
+/******************************************************************************
+* File Name: capsense_profile.c
+*
+* Description: This is the source code for the optional SysTick based frame
+*              profiler. Cortex-M0 has no cycle counter, so the stages are timed
+*              with SysTick running freely from the CPU clock.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "capsense_profile.h"
+
+#if (CAPSENSE_PROFILE_ENABLE != 0u)
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define PROFILE_COUNT_MAX              (0xFFFFu)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Statistics block, in the FSS control block to be read over EZI2C */
+static capsense_profile_t *profileData;
+
+/* SysTick count at the end of the last frame */
+static uint32_t lastFrame;
+static uint8_t lastFrameValid;
+
+/*******************************************************************************
+* Function Name: capsense_profile_init
+********************************************************************************
+* Summary:
+*  This function starts SysTick as a free running 24-bit down counter on the
+*  CPU clock, without interrupt, and clears the statistics. SysTick keeps
+*  counting in Sleep but stops in Deep Sleep, which the idle mode enters
+*  between wake-up scans. No stage is timed across Deep Sleep, and the
+*  frame period across it is skipped (capsense_profile_skip_frame()).
+*
+* Parameters:
+*  profile: where to keep the statistics
+*
+*******************************************************************************/
+void capsense_profile_init(capsense_profile_t *profile)
+{
+    profileData = profile;
+
+    SysTick->LOAD = SysTick_LOAD_RELOAD_Msk;
+    SysTick->VAL = 0u;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+
+    capsense_profile_reset();
+}
+
+
+/*******************************************************************************
+* Function Name: capsense_profile_reset
+********************************************************************************
+* Summary:
+*  This function clears the statistics of all stages.
+*
+*******************************************************************************/
+void capsense_profile_reset(void)
+{
+    uint8_t sequence = (uint8_t)(profileData->sequence + 1u);
+
+    profileData->sequenceEnd = sequence;
+    __DMB();
+
+    for (uint8_t stage = 0; stage < CAPSENSE_PROFILE_STAGE_COUNT; stage++)
+    {
+        capsense_profile_stage_t *data = &profileData->stage[stage];
+
+        data->count = 0;
+        data->min = 0;
+        data->max = 0;
+        data->mean = 0;
+        for (uint8_t bin = 0; bin < CAPSENSE_PROFILE_BINS; bin++)
+        {
+            data->histogram[bin] = 0;
+        }
+    }
+    lastFrameValid = 0;
+
+    __DMB();
+    profileData->sequence = sequence;
+}
+
+
+/*******************************************************************************
+* Function Name: capsense_profile_record
+********************************************************************************
+* Summary:
+*  This function adds a duration to the statistics of a stage. The EZI2C
+*  interrupt can read the block between any two stores, so the sequence
+*  bytes frame the update.
+*
+* Parameters:
+*  stage: the stage
+*  ticks: its duration in SysTick ticks
+*
+*******************************************************************************/
+void capsense_profile_record(capsense_profile_stage_id_t stage, uint32_t ticks)
+{
+    capsense_profile_stage_t *data = &profileData->stage[stage];
+    uint32_t scaled = ticks >> CAPSENSE_PROFILE_BIN_SHIFT;
+    uint8_t sequence = (uint8_t)(profileData->sequence + 1u);
+    uint8_t bin = 0;
+
+    profileData->sequenceEnd = sequence;
+    __DMB();
+
+    if (0u == data->count)
+    {
+        data->min = ticks;
+        data->max = ticks;
+        data->mean = ticks << CAPSENSE_PROFILE_MEAN_SHIFT;
+    }
+    else
+    {
+        data->min = (ticks < data->min) ? ticks : data->min;
+        data->max = (ticks > data->max) ? ticks : data->max;
+        data->mean = (data->mean - (data->mean >> CAPSENSE_PROFILE_MEAN_SHIFT)) + ticks;
+    }
+    data->count++;
+
+    /* Finding the log2 bin without a CLZ instruction */
+    while ((scaled > 1u) && (bin < (CAPSENSE_PROFILE_BINS - 1u)))
+    {
+        scaled >>= 1u;
+        bin++;
+    }
+    if (data->histogram[bin] < PROFILE_COUNT_MAX)
+    {
+        data->histogram[bin]++;
+    }
+
+    __DMB();
+    profileData->sequence = sequence;
+}
+
+
+/*******************************************************************************
+* Function Name: capsense_profile_frame
+********************************************************************************
+* Summary:
+*  This function marks the end of a frame and records the time since the
+*  end of the last one as the frame period.
+*
+*******************************************************************************/
+void capsense_profile_frame(void)
+{
+    uint32_t now = SysTick->VAL;
+
+    if (0u != lastFrameValid)
+    {
+        capsense_profile_record(CAPSENSE_PROFILE_FRAME, (lastFrame - now) & SysTick_LOAD_RELOAD_Msk);
+    }
+    lastFrame = now;
+    lastFrameValid = 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: capsense_profile_skip_frame
+********************************************************************************
+* Summary:
+*  This function drops the current frame period, which is not recorded, and
+*  the next one starts at the next capsense_profile_frame(). Call it before
+*  Deep Sleep, where SysTick stops.
+*
+*******************************************************************************/
+void capsense_profile_skip_frame(void)
+{
+    lastFrameValid = 0;
+}
+
+#endif /* CAPSENSE_PROFILE_ENABLE */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,161 @@
+/******************************************************************************
+* File Name: capsense_profile.h
+*
+* Description: This file contains the data layout and the function prototypes
+*              of the optional SysTick based frame profiler
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CAPSENSE_PROFILE_H
+#define CAPSENSE_PROFILE_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Set to 1 to time the stages of the main loop with SysTick and publish the
+ * results in the FSS control block. Refer README.md.
+ */
+#ifndef CAPSENSE_PROFILE_ENABLE
+#define CAPSENSE_PROFILE_ENABLE        (0u)
+#endif
+
+/* Histogram bin N counts the durations of 2^(N + 5) to 2^(N + 6) - 1 ticks;
+ * the first and last bins also count the shorter and longer ones.
+ */
+#define CAPSENSE_PROFILE_BINS          (16u)
+#define CAPSENSE_PROFILE_BIN_SHIFT     (5u)
+
+/* The mean is a moving average over about 2^CAPSENSE_PROFILE_MEAN_SHIFT
+ * samples, kept with as many fractional bits.
+ */
+#define CAPSENSE_PROFILE_MEAN_SHIFT    (4u)
+
+#if (CAPSENSE_PROFILE_ENABLE != 0u)
+#include "cy_pdl.h"
+#endif
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Timed stages of the main loop */
+typedef enum
+{
+    CAPSENSE_PROFILE_PROCESS,       /* Widget processing, per widget when pipelined */
+    CAPSENSE_PROFILE_FSS,           /* capsense_fss() */
+    CAPSENSE_PROFILE_LED,           /* led_control() */
+    CAPSENSE_PROFILE_TUNER,         /* Cy_CapSense_RunTuner() */
+    CAPSENSE_PROFILE_FRAME,         /* Period between two frames */
+    CAPSENSE_PROFILE_STAGE_COUNT
+} capsense_profile_stage_id_t;
+
+/* Statistics of one stage, in SysTick (CPU clock) ticks */
+typedef struct
+{
+    uint32_t count;                             /* Number of samples */
+    uint32_t min;
+    uint32_t max;
+    uint32_t mean;                              /* Moving average << CAPSENSE_PROFILE_MEAN_SHIFT */
+    uint16_t histogram[CAPSENSE_PROFILE_BINS];  /* Saturating counts per log2 bin */
+} capsense_profile_stage_t;
+
+/* Stage timings. The firmware writes sequenceEnd, then the statistics, then
+ * sequence with the same value; the host reads the block in one transaction
+ * and keeps the read only if sequence and sequenceEnd are equal, as for the
+ * status map.
+ */
+typedef struct
+{
+    uint8_t sequence;                                       /* Written last */
+    capsense_profile_stage_t stage[CAPSENSE_PROFILE_STAGE_COUNT];
+    uint8_t sequenceEnd;                                    /* Written first */
+} capsense_profile_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+#if (CAPSENSE_PROFILE_ENABLE != 0u)
+void capsense_profile_init(capsense_profile_t *profile);
+void capsense_profile_reset(void);
+void capsense_profile_record(capsense_profile_stage_id_t stage, uint32_t ticks);
+void capsense_profile_frame(void);
+void capsense_profile_skip_frame(void);
+#endif
+
+/*******************************************************************************
+* Function Name: capsense_profile_start
+********************************************************************************
+* Summary:
+*  Returns the SysTick count at the start of a stage.
+*
+*******************************************************************************/
+static inline uint32_t capsense_profile_start(void)
+{
+#if (CAPSENSE_PROFILE_ENABLE != 0u)
+    return SysTick->VAL;
+#else
+    return 0u;
+#endif
+}
+
+
+/*******************************************************************************
+* Function Name: capsense_profile_stop
+********************************************************************************
+* Summary:
+*  Records the duration of a stage started at start. Compiles to nothing
+*  when the profiler is disabled.
+*
+*******************************************************************************/
+static inline void capsense_profile_stop(capsense_profile_stage_id_t stage, uint32_t start)
+{
+#if (CAPSENSE_PROFILE_ENABLE != 0u)
+    /* SysTick counts down through 24 bits */
+    capsense_profile_record(stage, (start - SysTick->VAL) & SysTick_LOAD_RELOAD_Msk);
+#else
+    (void)stage;
+    (void)start;
+#endif
+}
+
+#endif /* CAPSENSE_PROFILE_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,109 @@
+/******************************************************************************
+* File Name: capsense_status_map.c
+*
+* Description: This is the source code for the compact status register map, a
+*              small alternative to the CAPSENSE tuner data structure for a host
+*              that only polls the button status.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "capsense_status_map.h"
+#include "cy_pdl.h"
+
+#if (CAPSENSE_STATUS_MAP_ENABLE != 0u)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+capsense_status_map_t capsense_status_map;
+
+/*******************************************************************************
+* Function Name: capsense_status_map_init
+********************************************************************************
+* Summary:
+*  This function clears the status map and the frame counter.
+*
+*******************************************************************************/
+void capsense_status_map_init(void)
+{
+    capsense_status_map.sequenceEnd = (uint8_t)(capsense_status_map.sequence + 1u);
+    __DMB();
+
+    for (uint32_t word = 0; word < FSS_WORD_COUNT; word++)
+    {
+        capsense_status_map.fssStatus.word[word] = 0;
+        capsense_status_map.rawStatus.word[word] = 0;
+    }
+    capsense_status_map.winner = FSS_NO_WINNER;
+    capsense_status_map.frame = 0;
+
+    __DMB();
+    capsense_status_map.sequence = capsense_status_map.sequenceEnd;
+}
+
+
+/*******************************************************************************
+* Function Name: capsense_status_map_update
+********************************************************************************
+* Summary:
+*  This function publishes the button status of the frame. Call it once per
+*  frame after capsense_fss(). The EZI2C interrupt can read the map between
+*  any two stores, so the sequence bytes frame the update.
+*
+*******************************************************************************/
+void capsense_status_map_update(void)
+{
+    uint8_t sequence = (uint8_t)(capsense_status_map.sequence + 1u);
+
+    capsense_status_map.sequenceEnd = sequence;
+    __DMB();
+
+    capsense_status_map.winner = capsense_fss_get_winner();
+    capsense_status_map.frame++;
+    capsense_status_map.fssStatus = *capsense_fss_get_status();
+    capsense_status_map.rawStatus = *capsense_fss_get_raw_status();
+
+    __DMB();
+    capsense_status_map.sequence = sequence;
+}
+
+#endif /* CAPSENSE_STATUS_MAP_ENABLE */
+
+
+/* [] END OF FILE */
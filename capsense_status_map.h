@@ -0,0 +1,97 @@
+/******************************************************************************
+* File Name: capsense_status_map.h
+*
+* Description: This file contains the layout and the function prototypes of the
+*              compact status register map exposed to the host in production
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CAPSENSE_STATUS_MAP_H
+#define CAPSENSE_STATUS_MAP_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "capsense_fss_algorithm.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Set to 1 to expose capsense_status_map instead of the CAPSENSE tuner data
+ * structure on the EZI2C primary address. Refer README.md.
+ */
+#ifndef CAPSENSE_STATUS_MAP_ENABLE
+#define CAPSENSE_STATUS_MAP_ENABLE     (0u)
+#endif
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Button status register map, refreshed every frame. The firmware writes
+ * sequenceEnd, then the status, then sequence with the same value; the
+ * host reads the map in one transaction from the start and keeps the read
+ * only if sequence and sequenceEnd are equal. Both are single bytes so that
+ * they cannot be torn between two bytes of the transfer.
+ */
+typedef struct
+{
+    uint8_t sequence;               /* Written last */
+    uint8_t winner;                 /* capsense_fss_get_winner() */
+    uint16_t frame;                 /* Frame counter, wraps */
+    fss_bitmap_t fssStatus;         /* Button status after FSS */
+    fss_bitmap_t rawStatus;         /* Button status before FSS */
+    uint8_t sequenceEnd;            /* Written first */
+} capsense_status_map_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+#if (CAPSENSE_STATUS_MAP_ENABLE != 0u)
+extern capsense_status_map_t capsense_status_map;
+#endif
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+#if (CAPSENSE_STATUS_MAP_ENABLE != 0u)
+void capsense_status_map_init(void);
+void capsense_status_map_update(void);
+#endif
+
+#endif /* CAPSENSE_STATUS_MAP_H */
+
+
+/* [] END OF FILE */
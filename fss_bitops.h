@@ -0,0 +1,152 @@
+/******************************************************************************
+* File Name: fss_bitops.h
+*
+* Description: This file contains the bit operations used by the flanking
+*              sensor suppression (FSS) algorithm on 32-bit status words.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef FSS_BITOPS_H
+#define FSS_BITOPS_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Implementations of the lowest set bit (count trailing zeros) search */
+#define FSS_CTZ_LOOP                   (0u)    /* Shift loop, up to 32 iterations */
+#define FSS_CTZ_BUILTIN                (1u)    /* __builtin_ctz(), for cores with CLZ */
+#define FSS_CTZ_DEBRUIJN               (2u)    /* De Bruijn multiply and table lookup */
+
+/* Cortex-M0 has no CLZ instruction, so __builtin_ctz() becomes a libgcc call
+ * there; the De Bruijn lookup is branch free and only needs a multiply.
+ */
+#ifndef FSS_CTZ_METHOD
+#if defined(__GNUC__) && (defined(__ARM_FEATURE_CLZ) || !defined(__arm__))
+#define FSS_CTZ_METHOD                 (FSS_CTZ_BUILTIN)
+#else
+#define FSS_CTZ_METHOD                 (FSS_CTZ_DEBRUIJN)
+#endif
+#endif
+
+#define FSS_DEBRUIJN_SEQUENCE          (0x077CB531u)
+#define FSS_DEBRUIJN_SHIFT             (27u)
+
+/*******************************************************************************
+* Function Name: fss_ctz_loop
+********************************************************************************
+* Summary:
+*  Returns the index of the lowest set bit of a non-zero word by shifting a
+*  probe bit up until it meets a set bit.
+*
+*******************************************************************************/
+static inline uint8_t fss_ctz_loop(uint32_t word)
+{
+    uint8_t bit = 0;
+
+    while (0u == (word & ((uint32_t)1u << bit)))
+    {
+        bit++;
+    }
+    return bit;
+}
+
+
+/*******************************************************************************
+* Function Name: fss_ctz_debruijn
+********************************************************************************
+* Summary:
+*  Returns the index of the lowest set bit of a non-zero word. The isolated
+*  bit times the De Bruijn sequence puts a unique 5-bit pattern in the top
+*  bits, which the table maps back to the bit position.
+*
+*******************************************************************************/
+static inline uint8_t fss_ctz_debruijn(uint32_t word)
+{
+    /* Bit position for every 5-bit window of the De Bruijn sequence */
+    static const uint8_t position[32] =
+    {
+         0,  1, 28,  2, 29, 14, 24,  3, 30, 22, 20, 15, 25, 17,  4,  8,
+        31, 27, 13, 23, 21, 19, 16,  7, 26, 12, 18,  6, 11,  5, 10,  9
+    };
+
+    return position[((word & (0u - word)) * FSS_DEBRUIJN_SEQUENCE) >> FSS_DEBRUIJN_SHIFT];
+}
+
+
+#if defined(__GNUC__)
+/*******************************************************************************
+* Function Name: fss_ctz_builtin
+********************************************************************************
+* Summary:
+*  Returns the index of the lowest set bit of a non-zero word using the
+*  compiler intrinsic.
+*
+*******************************************************************************/
+static inline uint8_t fss_ctz_builtin(uint32_t word)
+{
+    return (uint8_t)__builtin_ctz(word);
+}
+#endif
+
+
+/*******************************************************************************
+* Function Name: fss_ctz
+********************************************************************************
+* Summary:
+*  Returns the index of the lowest set bit of a non-zero word using the
+*  implementation selected by FSS_CTZ_METHOD.
+*
+*******************************************************************************/
+static inline uint8_t fss_ctz(uint32_t word)
+{
+#if (FSS_CTZ_METHOD == FSS_CTZ_BUILTIN)
+    return fss_ctz_builtin(word);
+#elif (FSS_CTZ_METHOD == FSS_CTZ_DEBRUIJN)
+    return fss_ctz_debruijn(word);
+#else
+    return fss_ctz_loop(word);
+#endif
+}
+
+#endif /* FSS_BITOPS_H */
+
+
+/* [] END OF FILE */
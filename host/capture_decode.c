@@ -0,0 +1,217 @@
+/******************************************************************************
+* File Name: capture_decode.c
+*
+* Description: Turns the bytes drained from the touch trace capture of the
+*              firmware (capsense_capture.c) into a recorded trace file that
+*              fss_bench, frame_sim and fss_replay replay. The status after
+*              FSS follows every entry as a comment.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fss_capture.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define DECODE_READ_CHUNK          (65536u)
+
+/*******************************************************************************
+* Function Name: decode_read
+********************************************************************************
+* Summary:
+*  Reads a whole file, or stdin for "-", into memory. Returns NULL on error.
+*
+*******************************************************************************/
+static uint8_t *decode_read(const char *path, size_t *size)
+{
+    FILE *file = (0 == strcmp(path, "-")) ? stdin : fopen(path, "rb");
+    uint8_t *data = NULL;
+    size_t capacity = 0u;
+    size_t count;
+
+    if (NULL == file)
+    {
+        return NULL;
+    }
+
+    *size = 0u;
+    do
+    {
+        if ((*size + DECODE_READ_CHUNK) > capacity)
+        {
+            capacity = (0u == capacity) ? DECODE_READ_CHUNK : (capacity * 2u);
+            data = realloc(data, capacity);
+            if (NULL == data)
+            {
+                perror("capture_decode");
+                exit(EXIT_FAILURE);
+            }
+        }
+        count = fread(&data[*size], 1u, DECODE_READ_CHUNK, file);
+        *size += count;
+    } while (count > 0u);
+
+    if (stdin != file)
+    {
+        fclose(file);
+    }
+    return data;
+}
+
+
+/*******************************************************************************
+* Function Name: decode_print_bitmap
+********************************************************************************
+* Summary:
+*  Prints a bitmap in hex, most significant byte first, without leading
+*  zeros.
+*
+*******************************************************************************/
+static void decode_print_bitmap(const uint8_t *bitmap)
+{
+    uint32_t byte = FSS_CAPTURE_BITMAP_BYTES;
+
+    while ((byte > 1u) && (0u == bitmap[byte - 1u]))
+    {
+        byte--;
+    }
+
+    printf("%x", bitmap[--byte]);
+    while (byte-- > 0u)
+    {
+        printf("%02x", bitmap[byte]);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: decode_print_entry
+********************************************************************************
+* Summary:
+*  Prints a trace entry: a status that lasted frames frames.
+*
+*******************************************************************************/
+static void decode_print_entry(uint32_t frames, const fss_capture_record_t *record)
+{
+    printf("%u ", frames);
+    decode_print_bitmap(record->raw);
+    printf("  # ");
+    decode_print_bitmap(record->fss);
+    printf("\n");
+}
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Usage: capture_decode [capture]
+*  Decodes the capture file (stdin by default), the bytes drained from the
+*  capture ring concatenated in order, and prints the trace. A record gives
+*  the status from its frame until the next record, and the last one is
+*  printed as lasting one frame. A record carries the frames since the
+*  record before it, the first one the frames since reset, its own included.
+*
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+    const char *path = (argc > 1) ? argv[1] : "-";
+    fss_capture_decoder_t decoder;
+    fss_capture_record_t record;
+    fss_capture_record_t previous;
+    size_t size;
+    uint8_t *data;
+    bool first = true;
+    int result;
+
+    if (argc > 2)
+    {
+        fprintf(stderr, "usage: %s [capture]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    data = decode_read(path, &size);
+    if (NULL == data)
+    {
+        fprintf(stderr, "%s: cannot read capture\n", path);
+        return EXIT_FAILURE;
+    }
+
+    printf("# Touch trace decoded from the capture %s\n", path);
+    printf("# <frames> <raw button bitmap>  # <button bitmap after FSS>\n");
+
+    /* The panel is untouched until the frame of the first record */
+    memset(&previous, 0, sizeof(previous));
+
+    fss_capture_init(&decoder, data, size);
+    while (1 == (result = fss_capture_next(&decoder, &record)))
+    {
+        /* The first record counts its own frame after the untouched ones */
+        uint32_t frames = first ? (record.frames - 1u) : record.frames;
+
+        if (0u != frames)
+        {
+            decode_print_entry(frames, &previous);
+        }
+        if (record.key)
+        {
+            printf("# records dropped: the entry above lasted longer\n");
+        }
+        previous = record;
+        first = false;
+    }
+
+    if (result < 0)
+    {
+        fprintf(stderr, "%s: malformed record at byte %zu\n", path, decoder.offset);
+    }
+    else if (!first)
+    {
+        decode_print_entry(1u, &previous);
+    }
+
+    free(data);
+    return (result < 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+
+/* [] END OF FILE */
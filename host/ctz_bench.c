@@ -0,0 +1,194 @@
+/******************************************************************************
+* File Name: ctz_bench.c
+*
+* Description: Host benchmark of the lowest set bit search used by the FSS
+*              algorithm when a new button is selected: the original 64-bit
+*              shift loop against the FSS_CTZ_* implementations.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "fss_bitops.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define CTZ_INPUTS                 (4096u)
+#define CTZ_REPEAT                 (2000u)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static uint64_t input[CTZ_INPUTS];
+static uint64_t worst_input[CTZ_INPUTS];
+
+/* Keeps the results alive so the compiler cannot drop the searches */
+volatile uint32_t ctz_sink;
+
+/*******************************************************************************
+* Function Name: ctz_shift_loop64
+********************************************************************************
+* Summary:
+*  The search that fss_algorithm() used before FSS_CTZ_*: returns the lowest
+*  set bit of a 64-bit status as a one-hot value.
+*
+*******************************************************************************/
+static uint64_t ctz_shift_loop64(uint64_t activeFssButtons)
+{
+    uint64_t reportedButtons;
+
+    for (reportedButtons = 1;
+         (0 == (reportedButtons & activeFssButtons)) && (0 != reportedButtons);
+         reportedButtons <<= 1)
+    {
+    }
+    return reportedButtons;
+}
+
+
+/*******************************************************************************
+* Function Name: ctz_word_search
+********************************************************************************
+* Summary:
+*  The word-at-a-time search of fss_algorithm(): skips an all-zero low word
+*  and returns the bit index found by the given implementation.
+*
+*******************************************************************************/
+static inline uint32_t ctz_word_search(uint64_t value, uint8_t (*ctz)(uint32_t))
+{
+    uint32_t low = (uint32_t)value;
+
+    return (0u != low) ? ctz(low) : (32u + ctz((uint32_t)(value >> 32)));
+}
+
+
+/*******************************************************************************
+* Function Name: ctz_time
+********************************************************************************
+* Summary:
+*  Returns the mean time in ns of one search over the given inputs.
+*
+*******************************************************************************/
+static double ctz_time(const uint64_t *values, uint8_t (*ctz)(uint32_t))
+{
+    struct timespec t0, t1;
+    uint32_t sum = 0u;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (uint32_t repeat = 0u; repeat < CTZ_REPEAT; repeat++)
+    {
+        for (uint32_t i = 0u; i < CTZ_INPUTS; i++)
+        {
+            sum += (NULL != ctz) ? ctz_word_search(values[i], ctz) :
+                                   (uint32_t)ctz_shift_loop64(values[i]);
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    ctz_sink = sum;
+
+    return (((double)(t1.tv_sec - t0.tv_sec) * 1e9) + (double)(t1.tv_nsec - t0.tv_nsec)) /
+           ((double)CTZ_REPEAT * CTZ_INPUTS);
+}
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Checks that all implementations agree, then times them on inputs whose
+*  lowest set bit is uniformly distributed over 64 bits and on the worst
+*  case for the loops (only bit 63 set).
+*
+*******************************************************************************/
+int main(void)
+{
+    static const struct
+    {
+        const char *name;
+        uint8_t (*ctz)(uint32_t);
+    } method[] =
+    {
+        { "64-bit shift loop (original)", NULL },
+        { "FSS_CTZ_LOOP", fss_ctz_loop },
+        { "FSS_CTZ_BUILTIN", fss_ctz_builtin },
+        { "FSS_CTZ_DEBRUIJN", fss_ctz_debruijn },
+    };
+    uint32_t state = 1u;
+
+    for (uint32_t i = 0u; i < CTZ_INPUTS; i++)
+    {
+        uint64_t noise;
+
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        noise = ((uint64_t)state << 32) | state;
+        input[i] = (noise | 1u) << (i % 64u);
+        worst_input[i] = (uint64_t)1u << 63;
+    }
+
+    for (uint32_t i = 0u; i < CTZ_INPUTS; i++)
+    {
+        uint64_t expected = ctz_shift_loop64(input[i]);
+
+        for (uint32_t m = 1u; m < (sizeof(method) / sizeof(method[0])); m++)
+        {
+            if (((uint64_t)1u << ctz_word_search(input[i], method[m].ctz)) != expected)
+            {
+                printf("%s disagrees for 0x%016llx\n", method[m].name, (unsigned long long)input[i]);
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    printf("%-30s %14s %14s\n", "lowest set bit search", "uniform ns", "bit 63 ns");
+    for (uint32_t m = 0u; m < (sizeof(method) / sizeof(method[0])); m++)
+    {
+        printf("%-30s %14.2f %14.2f\n", method[m].name,
+               ctz_time(input, method[m].ctz), ctz_time(worst_input, method[m].ctz));
+    }
+    printf("default FSS_CTZ_METHOD on this host: %u\n", (unsigned)FSS_CTZ_METHOD);
+
+    return EXIT_SUCCESS;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,637 @@
+/******************************************************************************
+* File Name: frame_sim.c
+*
+* Description: Host simulation of the event driven frame loop. Replays touch
+*              sequences through capsense_frame_wait()/capsense_frame_process()
+*              against a simulated scan interrupt, and checks that the FSS output
+*              matches calling capsense_fss() frame by frame. With the idle
+*              mode, it checks instead that a touch is reported as fast as
+*              at full rate.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "capsense_capture.h"
+#include "capsense_event.h"
+#include "capsense_frame.h"
+#include "capsense_fss_algorithm.h"
+#include "capsense_fss_tuner.h"
+#include "capsense_idle.h"
+#include "fss_capture.h"
+#include "fss_reference.h"
+#include "fss_trace.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SIM_DEFAULT_FRAMES         (20000u)
+#define SIM_DEFAULT_WAKEUP_PERIOD  (3u)
+
+/* No touch waiting to be reported */
+#define SIM_NO_TOUCH               (UINT32_MAX)
+
+/* Scans started from the first touched trace frame until FSS reports the
+ * touch: the frame itself and the next one, started before the frame is
+ * processed.
+ */
+#define SIM_TOUCH_LATENCY          (2u)
+
+/* Frames a focused loop may report a button after the reference does: when
+ * the held button is released, the buttons skipped while it was held are
+ * only scanned in the next frame.
+ */
+#define SIM_HANDOFF_LATENCY        (1u)
+
+/* A record was dropped on the full ring, and the ring was drained after the
+ * frame
+ */
+#define SIM_CAPTURE_DROPPED        (0x01u)
+#define SIM_CAPTURE_DRAINED        (0x02u)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const fss_trace_t *sim_trace;
+static uint32_t sim_next_frame;
+static uint32_t sim_frame_scans;
+static uint32_t sim_wakeup_period = SIM_DEFAULT_WAKEUP_PERIOD;
+#if (CAPSENSE_IDLE_ENABLE != 0u)
+static bool sim_touched;
+static uint32_t sim_touch_frame;
+static uint32_t sim_wake_scans;
+#endif
+#if (CAPSENSE_CAPTURE_ENABLE != 0u)
+static uint8_t *sim_capture;
+static size_t sim_capture_size;
+static size_t sim_capture_capacity;
+
+/* The ring is drained every that many frames */
+static uint32_t sim_capture_period = 1u;
+
+/* Output of every frame, and SIM_CAPTURE_xxx flags of every frame */
+static uint8_t *sim_capture_out;
+static uint8_t *sim_capture_flags;
+#endif
+
+/*******************************************************************************
+* Function Name: sim_source
+********************************************************************************
+* Summary:
+*  Gives each new frame scan the next frame of the trace.
+*
+*******************************************************************************/
+static const uint8_t *sim_source(void)
+{
+    const uint8_t *touch;
+
+    sim_frame_scans++;
+    if (sim_next_frame >= sim_trace->frames)
+    {
+        return NULL;
+    }
+    touch = fss_trace_frame(sim_trace, sim_next_frame);
+
+#if (CAPSENSE_IDLE_ENABLE != 0u)
+    {
+        bool touched = false;
+
+        for (uint32_t button = 0u; button < HOST_BUTTON_SENSOR_COUNT; button++)
+        {
+            touched |= (0u != touch[button]);
+        }
+
+        bool wakeScan = (host_capsense_get_stats()->wakeScans != sim_wake_scans);
+
+        sim_wake_scans = host_capsense_get_stats()->wakeScans;
+
+        /* Remember the first frame of a touch on a panel that was not
+         * touched. A wake-up scan of the ganged widget only starts a full
+         * frame, which must report the touch if it is still there.
+         */
+        if (touched && !sim_touched && (SIM_NO_TOUCH == sim_touch_frame))
+        {
+            sim_touch_frame = wakeScan ? (sim_next_frame + 1u) : sim_next_frame;
+        }
+        else if (!touched && (sim_touch_frame == sim_next_frame))
+        {
+            sim_touch_frame = SIM_NO_TOUCH;
+        }
+        sim_touched = touched;
+    }
+#endif
+
+    sim_next_frame++;
+    return touch;
+}
+
+
+#if (CAPSENSE_FRAME_FOCUS == 0u) && (CAPSENSE_IDLE_ENABLE == 0u)
+/*******************************************************************************
+* Function Name: sim_reference
+********************************************************************************
+* Summary:
+*  Returns the checksum of the output of the FSS reference model
+*  (fss_reference.c), one frame after the other: all buttons in one group,
+*  lowest first.
+*
+*******************************************************************************/
+static uint32_t sim_reference(const fss_trace_t *trace)
+{
+    static fss_reference_t ref;
+    uint32_t checksum = FSS_TRACE_CHECKSUM_INIT;
+    uint8_t out[HOST_BUTTON_SENSOR_COUNT];
+
+    fss_reference_init(&ref, HOST_BUTTON_SENSOR_COUNT, 1u, false, false);
+
+    for (uint32_t frame = 0u; frame < trace->frames; frame++)
+    {
+        fss_reference_frame(&ref, fss_trace_frame(trace, frame), NULL, out);
+        checksum = fss_trace_checksum(checksum, out, HOST_BUTTON_SENSOR_COUNT);
+    }
+
+    return checksum;
+}
+#endif
+
+
+#if (CAPSENSE_CAPTURE_ENABLE != 0u)
+/*******************************************************************************
+* Function Name: sim_capture_drain
+********************************************************************************
+* Summary:
+*  Drains the capture ring as the host does over EZI2C.
+*
+*******************************************************************************/
+static void sim_capture_drain(void)
+{
+    uint16_t head = capsense_fss_tuner.capture.head;
+    uint16_t tail = capsense_fss_tuner.captureTail;
+
+    while (tail != head)
+    {
+        if (sim_capture_size == sim_capture_capacity)
+        {
+            sim_capture_capacity = (0u == sim_capture_capacity) ? 4096u : (sim_capture_capacity * 2u);
+            sim_capture = realloc(sim_capture, sim_capture_capacity);
+            if (NULL == sim_capture)
+            {
+                perror("frame_sim");
+                exit(EXIT_FAILURE);
+            }
+        }
+        sim_capture[sim_capture_size++] = capsense_fss_tuner.capture.data[tail & CAPSENSE_CAPTURE_RING_MASK];
+        tail++;
+    }
+    capsense_fss_tuner.captureTail = tail;
+}
+
+
+/*******************************************************************************
+* Function Name: sim_capture_check
+********************************************************************************
+* Summary:
+*  Decodes the capture of a run and returns the number of frames whose raw
+*  status differs from the trace or whose status after FSS differs from the
+*  output of the run, plus one if a record is left over. After a dropped
+*  record, the decoded status is stale until the next record, which must be
+*  a key record, written at the latest in the frame after the next drain.
+*
+*******************************************************************************/
+static uint32_t sim_capture_check(const fss_trace_t *trace)
+{
+    fss_capture_decoder_t decoder;
+    fss_capture_record_t status;
+    fss_capture_record_t next;
+    uint32_t nextFrame;
+    uint32_t errors = 0u;
+    bool stale = false;
+    int result;
+
+    memset(&status, 0, sizeof(status));
+    fss_capture_init(&decoder, sim_capture, sim_capture_size);
+    result = fss_capture_next(&decoder, &next);
+    nextFrame = (1 == result) ? (next.frames - 1u) : UINT32_MAX;
+
+    for (uint32_t frame = 0u; frame < trace->frames; frame++)
+    {
+        const uint8_t *touch = fss_trace_frame(trace, frame);
+        const uint8_t *out = &sim_capture_out[(size_t)frame * HOST_BUTTON_SENSOR_COUNT];
+
+        if (frame == nextFrame)
+        {
+            status = next;
+            errors += (status.key != stale) ? 1u : 0u;
+            stale = false;
+            result = fss_capture_next(&decoder, &next);
+            nextFrame = (1 == result) ? (nextFrame + next.frames) : UINT32_MAX;
+        }
+        else if (stale && (0u != (sim_capture_flags[frame - 1u] & SIM_CAPTURE_DRAINED)))
+        {
+            /* The key record did not follow the drain */
+            errors++;
+        }
+        stale = stale || (0u != (sim_capture_flags[frame] & SIM_CAPTURE_DROPPED));
+
+        if (stale)
+        {
+            continue;
+        }
+        for (uint32_t button = 0u; button < HOST_BUTTON_SENSOR_COUNT; button++)
+        {
+            if ((((status.raw[button / 8u] >> (button % 8u)) & 1u) != (uint8_t)(0u != touch[button])) ||
+                (((status.fss[button / 8u] >> (button % 8u)) & 1u) != out[button]))
+            {
+                errors++;
+                break;
+            }
+        }
+    }
+
+    /* Every record decoded and used */
+    errors += (0 != result) ? 1u : 0u;
+    return errors;
+}
+#endif
+
+
+/*******************************************************************************
+* Function Name: sim_run
+********************************************************************************
+* Summary:
+*  Runs the main loop of main.c over a trace, prints a result row and
+*  returns non-zero if the output or the event counts are wrong. The touch
+*  events are drained every frame and must rebuild the FSS output.
+*
+*  With the idle mode, wake-up scans take trace frames without completing a
+*  frame, so the output is not compared with the reference. Instead, a touch
+*  of a panel that was not touched must be reported in the frame that scans
+*  it, as it is at full rate. With the ganged wake-up widget of the mock, it
+*  is the full frame after the wake-up scan, and that widget must not be
+*  scanned in full-rate frames.
+*
+*******************************************************************************/
+static int sim_run(const char *name, const fss_trace_t *trace)
+{
+#if (CAPSENSE_FRAME_FOCUS != 0u)
+    static fss_reference_t ref;
+    uint8_t expected[HOST_BUTTON_SENSOR_COUNT];
+    uint32_t focusErrors = 0u;
+    uint32_t lateFrames = 0u;
+    bool wasSelected = false;
+#elif (CAPSENSE_IDLE_ENABLE != 0u)
+    uint32_t latencyErrors = 0u;
+#else
+    uint32_t reference = sim_reference(trace);
+#endif
+    uint32_t checksum = FSS_TRACE_CHECKSUM_INIT;
+    uint8_t out[HOST_BUTTON_SENSOR_COUNT];
+    uint8_t replay[HOST_BUTTON_SENSOR_COUNT] = {0};
+    uint32_t eventErrors = 0u;
+    uint32_t frame = 0u;
+    uint32_t tunerRuns;
+    capsense_event_t event;
+    const host_capsense_stats_t *stats;
+    int failed;
+
+    sim_trace = trace;
+    sim_next_frame = 0u;
+    sim_frame_scans = 0u;
+#if (CAPSENSE_CAPTURE_ENABLE != 0u)
+    uint16_t captureOverflow = 0u;
+
+    sim_capture_size = 0u;
+    sim_capture_out = malloc((size_t)trace->frames * HOST_BUTTON_SENSOR_COUNT);
+    sim_capture_flags = calloc(trace->frames, sizeof(sim_capture_flags[0]));
+    if ((NULL == sim_capture_out) || (NULL == sim_capture_flags))
+    {
+        perror("frame_sim");
+        exit(EXIT_FAILURE);
+    }
+#endif
+#if (CAPSENSE_IDLE_ENABLE != 0u)
+    sim_touched = false;
+    sim_touch_frame = SIM_NO_TOUCH;
+    sim_wake_scans = 0u;
+#endif
+
+    host_capsense_init();
+    capsense_fss_init();
+    capsense_fss_tuner_init();
+    capsense_frame_init();
+    host_capsense_set_scan_source(sim_source, sim_wakeup_period);
+#if (CAPSENSE_FRAME_FOCUS != 0u)
+    fss_reference_init(&ref, HOST_BUTTON_SENSOR_COUNT, 1u, false, false);
+#endif
+
+    capsense_frame_start();
+    /* Until the frame scan after the last trace frame is started */
+    while (sim_frame_scans <= trace->frames)
+    {
+        capsense_frame_wait();
+        if (capsense_frame_process())
+        {
+            host_capsense_get_buttons(out);
+            checksum = fss_trace_checksum(checksum, out, HOST_BUTTON_SENSOR_COUNT);
+
+            while (capsense_event_read(&event))
+            {
+                if ((event.frame != (uint16_t)frame) || (event.sensor >= HOST_BUTTON_SENSOR_COUNT))
+                {
+                    eventErrors++;
+                }
+                else if (CAPSENSE_EVENT_SUPPRESSED != event.type)
+                {
+                    replay[event.sensor] = (CAPSENSE_EVENT_PRESS == event.type) ? 1u : 0u;
+                }
+            }
+            eventErrors += (0 != memcmp(replay, out, sizeof(out))) ? 1u : 0u;
+#if (CAPSENSE_CAPTURE_ENABLE != 0u)
+            /* Drained every sim_capture_period frames, so that records are
+             * dropped on a full ring when the period is long
+             */
+            memcpy(&sim_capture_out[(size_t)frame * HOST_BUTTON_SENSOR_COUNT], out, sizeof(out));
+            if (capsense_fss_tuner.capture.overflow != captureOverflow)
+            {
+                sim_capture_flags[frame] |= SIM_CAPTURE_DROPPED;
+                captureOverflow = capsense_fss_tuner.capture.overflow;
+            }
+            if (0u == ((frame + 1u) % sim_capture_period))
+            {
+                sim_capture_drain();
+                sim_capture_flags[frame] |= SIM_CAPTURE_DRAINED;
+            }
+#endif
+
+#if (CAPSENSE_IDLE_ENABLE != 0u)
+            if (SIM_NO_TOUCH != sim_touch_frame)
+            {
+                bool selected = false;
+
+                for (uint32_t button = 0u; button < HOST_BUTTON_SENSOR_COUNT; button++)
+                {
+                    selected |= (0u != out[button]);
+                }
+                if (selected || (sim_next_frame >= (sim_touch_frame + SIM_TOUCH_LATENCY)))
+                {
+                    latencyErrors += selected ? 0u : 1u;
+                    sim_touch_frame = SIM_NO_TOUCH;
+                }
+            }
+#endif
+
+#if (CAPSENSE_FRAME_FOCUS != 0u)
+            /* Skipped sensors keep a stale status, so the output can differ
+             * from the reference for a frame after a release, but FSS must
+             * still select touched buttons only, at most one FSS button per
+             * group.
+             */
+            {
+                const uint8_t *touch = fss_trace_frame(trace, frame);
+                const fss_group_t *groups;
+                uint8_t groupCount = capsense_fss_get_groups(&groups);
+                const fss_bitmap_t *enabled = capsense_fss_get_enable_mask();
+
+                for (uint32_t button = 0u; button < HOST_BUTTON_SENSOR_COUNT; button++)
+                {
+                    focusErrors += ((0u != out[button]) && (0u == touch[button])) ? 1u : 0u;
+                }
+                for (uint8_t group = 0u; group < groupCount; group++)
+                {
+                    uint32_t selected = 0u;
+
+                    for (uint32_t button = groups[group].firstSensor;
+                         button < (uint32_t)(groups[group].firstSensor + groups[group].sensorCount); button++)
+                    {
+                        selected += ((0u != out[button]) &&
+                                     (0u != ((enabled->word[button / FSS_WORD_BITS] >> (button % FSS_WORD_BITS)) & 1u))) ?
+                                    1u : 0u;
+                    }
+                    focusErrors += (selected > 1u) ? 1u : 0u;
+                }
+            }
+
+            /* A button the reference selects must be reported at most
+             * SIM_HANDOFF_LATENCY frames later, and only right after the
+             * release of a selected button.
+             */
+            {
+                bool selected = false;
+                bool reference = false;
+
+                fss_reference_frame(&ref, fss_trace_frame(trace, frame), NULL, expected);
+                for (uint32_t button = 0u; button < HOST_BUTTON_SENSOR_COUNT; button++)
+                {
+                    selected |= (0u != out[button]);
+                    reference |= (0u != expected[button]);
+                }
+                lateFrames = (reference && !selected) ? (lateFrames + 1u) : 0u;
+                focusErrors += ((0u != lateFrames) && (!wasSelected || (lateFrames > SIM_HANDOFF_LATENCY))) ?
+                               1u : 0u;
+                wasSelected = selected;
+            }
+#endif
+            frame++;
+        }
+    }
+
+    stats = host_capsense_get_stats();
+
+#if (CAPSENSE_IDLE_ENABLE != 0u)
+    /* The tuner is not serviced for frames completed by a wake-up scan */
+    tunerRuns = stats->tunerRuns;
+#elif (CAPSENSE_TUNER_PERIOD != 0u)
+    tunerRuns = trace->frames / CAPSENSE_TUNER_PERIOD;
+#else
+    tunerRuns = 0u;
+#endif
+
+    /* The FSS control block holds the last frame, with matching sequence
+     * bytes
+     */
+    eventErrors += (capsense_fss_tuner.statusSequence != capsense_fss_tuner.statusSequenceEnd) ||
+                   (capsense_fss_tuner.winner != capsense_fss_get_winner()) ||
+                   (0 != memcmp(&capsense_fss_tuner.rawStatus, capsense_fss_get_raw_status(), sizeof(fss_bitmap_t))) ||
+                   (0 != memcmp(&capsense_fss_tuner.fssStatus, capsense_fss_get_status(), sizeof(fss_bitmap_t)));
+
+#if (CAPSENSE_STATUS_MAP_ENABLE != 0u)
+    /* The status map holds the last frame, with matching sequence bytes */
+    eventErrors += (capsense_status_map.sequence != capsense_status_map.sequenceEnd) ||
+                   (capsense_status_map.frame != (uint16_t)frame) ||
+                   (0 != memcmp(&capsense_status_map.fssStatus, capsense_fss_get_status(), sizeof(fss_bitmap_t)));
+#endif
+
+    /* Every frame scanned once plus the one started last, no scan started
+     * while another runs, no widget processed while it is scanned and the
+     * tuner serviced once every CAPSENSE_TUNER_PERIOD frames.
+     */
+#if (CAPSENSE_FRAME_FOCUS != 0u)
+    failed = (0u != focusErrors);
+#elif (CAPSENSE_IDLE_ENABLE != 0u)
+    /* No Deep Sleep entered while a scan runs, and the ganged widget only
+     * scanned once after each Deep Sleep, never in a full-rate frame
+     */
+    failed = (0u != latencyErrors) || (0u != stats->busyDeepSleeps) ||
+             ((0u != HOST_WAKE_WIDGET_ENABLE) && (stats->wakeScans != stats->deepSleeps));
+#else
+    failed = (checksum != reference);
+    failed |= (frame != trace->frames);
+#endif
+#if (CAPSENSE_CAPTURE_ENABLE != 0u)
+    /* The capture rebuilds the trace and the FSS output, but where records
+     * were dropped, and without a drop when drained every frame
+     */
+    sim_capture_drain();
+    failed |= (0u != sim_capture_check(trace)) ||
+              ((1u == sim_capture_period) && (0u != capsense_fss_tuner.capture.overflow));
+    free(sim_capture_out);
+    free(sim_capture_flags);
+#endif
+    failed |= (sim_frame_scans != (trace->frames + 1u)) ||
+             (0u != stats->busyStarts) || (0u != stats->rawRaces) || (0u != eventErrors) ||
+             (0u != capsense_fss_tuner.events.overflow) || (stats->tunerRuns != tunerRuns);
+
+    printf("%-24.24s %9u %9u %9u %9u  0x%08x  %s\n", name, trace->frames, stats->scans,
+           stats->sleeps, stats->otherWakeups, checksum, failed ? "FAIL" : "ok");
+
+    return failed;
+}
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Usage: frame_sim [-n frames] [-s seed] [-w wakeup period] [-c drain period]
+*                   [trace ...]
+*  Runs every synthetic scenario, then every recorded trace given on the
+*  command line. With -w, every that many sleeps are ended by a non-CAPSENSE
+*  interrupt (0 for none). With the capture, -c drains the ring every that
+*  many frames rather than every frame. Exits with failure if any sequence
+*  fails.
+*
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+    uint32_t frames = SIM_DEFAULT_FRAMES;
+    uint32_t seed = 1u;
+    fss_trace_t trace;
+    int failed = 0;
+    int opt;
+
+    while (-1 != (opt = getopt(argc, argv, "n:s:w:c:")))
+    {
+        switch (opt)
+        {
+            case 'n':
+                frames = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 's':
+                seed = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'w':
+                sim_wakeup_period = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+#if (CAPSENSE_CAPTURE_ENABLE != 0u)
+            case 'c':
+                sim_capture_period = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+#endif
+            default:
+                fprintf(stderr, "usage: %s [-n frames] [-s seed] [-w wakeup period] [-c drain period] [trace ...]\n",
+                        argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+#if (CAPSENSE_CAPTURE_ENABLE != 0u)
+    if (0u == sim_capture_period)
+    {
+        fprintf(stderr, "drain period must be at least 1\n");
+        return EXIT_FAILURE;
+    }
+#endif
+
+    /* With 1, no sleep would ever end on the scan interrupt */
+    if (1u == sim_wakeup_period)
+    {
+        fprintf(stderr, "wakeup period must be 0 or at least 2\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("panel: %u button sensors in %u widgets, %s%s%s, every %u sleeps ended by another interrupt\n",
+           (unsigned)HOST_BUTTON_SENSOR_COUNT, (unsigned)CY_CAPSENSE_WIDGET_COUNT,
+           (0u == CAPSENSE_FRAME_PIPELINE) ? "not pipelined" :
+           (0u != CAPSENSE_FRAME_FOCUS) ? "pipelined and focused" : "pipelined",
+           (0u == CAPSENSE_IDLE_ENABLE) ? "" :
+           (0u != HOST_WAKE_WIDGET_ENABLE) ? ", idle when quiet, woken by a ganged widget" : ", idle when quiet",
+           (0u != CAPSENSE_CAPTURE_ENABLE) ? ", captured" : "", sim_wakeup_period);
+#if (CAPSENSE_CAPTURE_ENABLE != 0u)
+    printf("capture ring of %u bytes drained every %u frames\n", (unsigned)CAPSENSE_CAPTURE_RING_SIZE,
+           sim_capture_period);
+#endif
+    printf("%-24s %9s %9s %9s %9s  %-10s  %s\n", "sequence", "frames", "scans", "sleeps",
+           "other irq", "checksum", "result");
+
+    for (uint32_t scenario = 0u; scenario < FSS_TRACE_SCENARIO_COUNT; scenario++)
+    {
+        fss_trace_synthesize(&trace, HOST_BUTTON_SENSOR_COUNT, (fss_trace_scenario_t)scenario,
+                             frames, seed);
+        failed |= sim_run(fss_trace_scenario_name((fss_trace_scenario_t)scenario), &trace);
+        fss_trace_free(&trace);
+    }
+
+    for (int arg = optind; arg < argc; arg++)
+    {
+        if (0 != fss_trace_load(&trace, HOST_BUTTON_SENSOR_COUNT, argv[arg]))
+        {
+            fprintf(stderr, "%s: cannot read trace\n", argv[arg]);
+            return EXIT_FAILURE;
+        }
+        failed |= sim_run(argv[arg], &trace);
+        fss_trace_free(&trace);
+    }
+
+    return (0 != failed) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+
+/* [] END OF FILE */
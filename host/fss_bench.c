@@ -0,0 +1,477 @@
+/******************************************************************************
+* File Name: fss_bench.c
+*
+* Description: Host benchmark driver for the flanking sensor suppression
+*              (FSS) algorithm. Replays synthetic and recorded touch
+*              sequences through capsense_fss() against the mock CAPSENSE
+*              context and reports the per-frame cost.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include "capsense_fss_algorithm.h"
+#include "fss_trace.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BENCH_DEFAULT_FRAMES       (200000u)
+#define BENCH_CALIBRATION_LOOPS    (10000u)
+#define BENCH_HISTOGRAM_NS         (8192u)
+#define BENCH_PERCENTILE           (0.999)
+
+#define BENCH_PARANOID_PATH        "/proc/sys/kernel/perf_event_paranoid"
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    double   nsPerFrame;
+    double   p999Ns;
+    double   worstNs;
+    double   insnPerFrame;
+    uint32_t checksum;
+} bench_result_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static int perf_fd = -1;
+static int perf_error;                      /* errno of the failed counter setup */
+static double timer_overhead_ns;
+static double counter_overhead_insn;
+static uint32_t frame_histogram[BENCH_HISTOGRAM_NS];
+
+/* Number of consecutive sensors per FSS group, 0 for the built-in table */
+static uint32_t group_size;
+
+/* Neighbours on each side of a sensor in a row of keys, 0 for no neighbour
+ * table
+ */
+static uint32_t neighbour_distance;
+static fss_bitmap_t neighbour_table[HOST_BUTTON_SENSOR_COUNT];
+
+/*******************************************************************************
+* Function Name: now_ns
+********************************************************************************
+* Summary:
+*  Returns the monotonic clock in nanoseconds.
+*
+*******************************************************************************/
+static inline uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000u) + (uint64_t)ts.tv_nsec;
+}
+
+
+/*******************************************************************************
+* Function Name: read_insn
+********************************************************************************
+* Summary:
+*  Returns the user-space retired instruction count of this thread.
+*
+*******************************************************************************/
+static inline uint64_t read_insn(void)
+{
+    uint64_t count = 0u;
+
+    if (sizeof(count) != read(perf_fd, &count, sizeof(count)))
+    {
+        count = 0u;
+    }
+    return count;
+}
+
+
+/*******************************************************************************
+* Function Name: bench_calibrate
+********************************************************************************
+* Summary:
+*  Opens the instruction counter, if the kernel allows it, and measures the
+*  cost of an empty timing/counting pair so it can be subtracted per frame.
+*
+*******************************************************************************/
+static void bench_calibrate(void)
+{
+    struct perf_event_attr attr;
+    uint64_t best = UINT64_MAX;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    perf_fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    if (perf_fd < 0)
+    {
+        perf_error = errno;
+    }
+    else
+    {
+        uint64_t count;
+
+        /* Some hypervisors open the counter but cannot read it */
+        if (sizeof(count) != read(perf_fd, &count, sizeof(count)))
+        {
+            perf_error = errno;
+            close(perf_fd);
+            perf_fd = -1;
+        }
+    }
+
+    for (uint32_t i = 0u; i < BENCH_CALIBRATION_LOOPS; i++)
+    {
+        uint64_t t0 = now_ns();
+        uint64_t t1 = now_ns();
+
+        if ((t1 - t0) < best)
+        {
+            best = t1 - t0;
+        }
+    }
+    timer_overhead_ns = (double)best;
+
+    if (perf_fd >= 0)
+    {
+        best = UINT64_MAX;
+        for (uint32_t i = 0u; i < BENCH_CALIBRATION_LOOPS; i++)
+        {
+            uint64_t c0 = read_insn();
+            uint64_t c1 = read_insn();
+
+            if ((c1 - c0) < best)
+            {
+                best = c1 - c0;
+            }
+        }
+        counter_overhead_insn = (double)best;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: bench_counter_diagnostic
+********************************************************************************
+* Summary:
+*  Reports that the instruction counter is unavailable, on stdout with the
+*  results, and why, with the current perf_event_paranoid level, on stderr.
+*
+*******************************************************************************/
+static void bench_counter_diagnostic(void)
+{
+    FILE *paranoid = fopen(BENCH_PARANOID_PATH, "r");
+    int level;
+
+    printf("insn/frame: unavailable (perf_event_open: %s), compare ns/frame\n", strerror(perf_error));
+
+    fprintf(stderr, "fss_bench: cannot count instructions: perf_event_open: %s\n", strerror(perf_error));
+    if ((NULL != paranoid) && (1 == fscanf(paranoid, "%d", &level)) && (level > 2))
+    {
+        fprintf(stderr, "fss_bench: %s is %d, counting user-space instructions needs 2 or less, "
+                "or CAP_PERFMON\n", BENCH_PARANOID_PATH, level);
+    }
+    else if ((ENOENT == perf_error) || (EOPNOTSUPP == perf_error))
+    {
+        fprintf(stderr, "fss_bench: the CPU exposes no instruction counter, as in most virtual machines\n");
+    }
+    if (NULL != paranoid)
+    {
+        fclose(paranoid);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: bench_setup
+********************************************************************************
+* Summary:
+*  Resets the mock context and FSS, and splits the panel into groups of
+*  group_size sensors or loads a neighbour table for a row of keys when
+*  requested.
+*
+*******************************************************************************/
+static void bench_setup(void)
+{
+    fss_group_t groups[HOST_BUTTON_SENSOR_COUNT];
+    uint32_t count = 0u;
+
+    host_capsense_init();
+    capsense_fss_init();
+
+    if (0u != group_size)
+    {
+        for (uint32_t first = 0u; first < HOST_BUTTON_SENSOR_COUNT; first += group_size)
+        {
+            groups[count].firstSensor = (uint8_t)first;
+            groups[count].sensorCount = (uint8_t)(((first + group_size) <= HOST_BUTTON_SENSOR_COUNT) ?
+                                                  group_size : (HOST_BUTTON_SENSOR_COUNT - first));
+            count++;
+        }
+        if (!capsense_fss_set_groups(groups, (uint8_t)count))
+        {
+            fprintf(stderr, "invalid group size %u\n", group_size);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    if (0u != neighbour_distance)
+    {
+        memset(neighbour_table, 0, sizeof(neighbour_table));
+        for (uint32_t sensor = 0u; sensor < HOST_BUTTON_SENSOR_COUNT; sensor++)
+        {
+            for (uint32_t other = 0u; other < HOST_BUTTON_SENSOR_COUNT; other++)
+            {
+                if ((other != sensor) && ((other + neighbour_distance) >= sensor) &&
+                    (other <= (sensor + neighbour_distance)))
+                {
+                    neighbour_table[sensor].word[other / FSS_WORD_BITS] |= (fss_word_t)1u << (other % FSS_WORD_BITS);
+                }
+            }
+        }
+        if (!capsense_fss_set_neighbours(neighbour_table, HOST_BUTTON_SENSOR_COUNT))
+        {
+            fprintf(stderr, "invalid neighbour table\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: bench_replay
+********************************************************************************
+* Summary:
+*  Replays a trace through capsense_fss(). The first pass times every frame
+*  and checksums the post-FSS status, the second pass counts instructions.
+*  The worst case includes host preemption; the 99.9th percentile is the
+*  better estimate of the worst path through the algorithm.
+*  Only the capsense_fss() call is inside the measured window; setting the
+*  sensor status stands in for Cy_CapSense_ProcessAllWidgets().
+*
+*******************************************************************************/
+static bench_result_t bench_replay(const fss_trace_t *trace)
+{
+    bench_result_t result = { 0.0, 0.0, 0.0, 0.0, FSS_TRACE_CHECKSUM_INIT };
+    uint8_t out[HOST_BUTTON_SENSOR_COUNT];
+    uint64_t total = 0u;
+    uint64_t worst = 0u;
+    uint64_t below = 0u;
+    uint32_t bucket = 0u;
+
+    memset(frame_histogram, 0, sizeof(frame_histogram));
+
+    bench_setup();
+    for (uint32_t frame = 0u; frame < trace->frames; frame++)
+    {
+        host_capsense_set_buttons(fss_trace_frame(trace, frame));
+
+        uint64_t t0 = now_ns();
+        capsense_fss();
+        uint64_t t1 = now_ns();
+
+        total += (t1 - t0);
+        if ((t1 - t0) > worst)
+        {
+            worst = t1 - t0;
+        }
+        frame_histogram[((t1 - t0) < BENCH_HISTOGRAM_NS) ? (t1 - t0) : (BENCH_HISTOGRAM_NS - 1u)]++;
+
+        host_capsense_get_buttons(out);
+        result.checksum = fss_trace_checksum(result.checksum, out, HOST_BUTTON_SENSOR_COUNT);
+    }
+
+    result.nsPerFrame = ((double)total / trace->frames) - timer_overhead_ns;
+    result.worstNs = (double)worst - timer_overhead_ns;
+    while ((below += frame_histogram[bucket]) < (uint64_t)(trace->frames * BENCH_PERCENTILE))
+    {
+        bucket++;
+    }
+    result.p999Ns = (double)bucket - timer_overhead_ns;
+
+    if (perf_fd >= 0)
+    {
+        uint64_t insn = 0u;
+
+        bench_setup();
+        for (uint32_t frame = 0u; frame < trace->frames; frame++)
+        {
+            host_capsense_set_buttons(fss_trace_frame(trace, frame));
+
+            uint64_t c0 = read_insn();
+            capsense_fss();
+            uint64_t c1 = read_insn();
+
+            insn += (c1 - c0);
+        }
+        result.insnPerFrame = ((double)insn / trace->frames) - counter_overhead_insn;
+    }
+
+    return result;
+}
+
+
+/*******************************************************************************
+* Function Name: bench_report
+********************************************************************************
+* Summary:
+*  Replays one trace and prints a result row.
+*
+*******************************************************************************/
+static void bench_report(const char *name, const fss_trace_t *trace)
+{
+    bench_result_t result = bench_replay(trace);
+    char insn[16];
+
+    if (perf_fd >= 0)
+    {
+        snprintf(insn, sizeof(insn), "%10.1f", result.insnPerFrame);
+    }
+    else
+    {
+        snprintf(insn, sizeof(insn), "%10s", "unavail");
+    }
+
+    printf("%-24.24s %9u %10.1f %10.1f %10.1f %s  0x%08x\n", name, trace->frames,
+           result.nsPerFrame, result.p999Ns, result.worstNs, insn, result.checksum);
+}
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Usage: fss_bench [-n frames] [-s seed] [-g group size] [-a distance] [trace ...]
+*  Runs every synthetic scenario, then every recorded trace given on the
+*  command line, against the panel layout this binary was compiled for.
+*  With -g, the panel is split into FSS groups of that many sensors. With -a,
+*  the panel is a row of keys, each the neighbour of the keys up to that
+*  many places away, and FSS uses the neighbour table.
+*
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+    uint32_t frames = BENCH_DEFAULT_FRAMES;
+    uint32_t seed = 1u;
+    fss_trace_t trace;
+    int opt;
+
+    while (-1 != (opt = getopt(argc, argv, "n:s:g:a:")))
+    {
+        switch (opt)
+        {
+            case 'n':
+                frames = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 's':
+                seed = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'g':
+                group_size = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'a':
+                neighbour_distance = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-n frames] [-s seed] [-g group size] [-a distance] [trace ...]\n",
+                        argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    bench_calibrate();
+
+    printf("panel: %u button sensors in %u widgets (%u non-button), ",
+           (unsigned)HOST_BUTTON_SENSOR_COUNT, (unsigned)CY_CAPSENSE_WIDGET_COUNT,
+           (unsigned)HOST_OTHER_WIDGET_COUNT);
+    if (0u != neighbour_distance)
+    {
+        printf("FSS neighbours up to %u keys away\n", neighbour_distance);
+    }
+    else if (0u != group_size)
+    {
+        printf("FSS groups of %u sensors\n", group_size);
+    }
+    else
+    {
+        printf("built-in FSS groups\n");
+    }
+    if (perf_fd < 0)
+    {
+        bench_counter_diagnostic();
+    }
+    printf("%-24s %9s %10s %10s %10s %10s  %s\n", "sequence", "frames", "ns/frame",
+           "p99.9 ns", "worst ns", "insn/frame", "checksum");
+
+    for (uint32_t scenario = 0u; scenario < FSS_TRACE_SCENARIO_COUNT; scenario++)
+    {
+        fss_trace_synthesize(&trace, HOST_BUTTON_SENSOR_COUNT, (fss_trace_scenario_t)scenario,
+                             frames, seed);
+        bench_report(fss_trace_scenario_name((fss_trace_scenario_t)scenario), &trace);
+        fss_trace_free(&trace);
+    }
+
+    for (int arg = optind; arg < argc; arg++)
+    {
+        if (0 != fss_trace_load(&trace, HOST_BUTTON_SENSOR_COUNT, argv[arg]))
+        {
+            fprintf(stderr, "%s: cannot read trace\n", argv[arg]);
+            return EXIT_FAILURE;
+        }
+        bench_report(argv[arg], &trace);
+        fss_trace_free(&trace);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+/* [] END OF FILE */
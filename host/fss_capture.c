@@ -0,0 +1,183 @@
+/******************************************************************************
+* File Name: fss_capture.c
+*
+* Description: Decoder of the touch trace capture of capsense_capture.c for
+*              the host harness. The record format is described in
+*              capsense_capture.h.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <string.h>
+#include "capsense_capture.h"
+#include "fss_capture.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define CAPTURE_VARINT_BITS        (35u)
+
+/*******************************************************************************
+* Function Name: capture_varint
+********************************************************************************
+* Summary:
+*  Reads an unsigned LEB128 varint. Returns 0 on success.
+*
+*******************************************************************************/
+static int capture_varint(fss_capture_decoder_t *decoder, uint32_t *value)
+{
+    uint64_t result = 0u;
+
+    for (uint32_t shift = 0u; shift < CAPTURE_VARINT_BITS; shift += 7u)
+    {
+        uint8_t byte;
+
+        if (decoder->offset >= decoder->size)
+        {
+            return -1;
+        }
+        byte = decoder->data[decoder->offset++];
+        result |= (uint64_t)(byte & 0x7Fu) << shift;
+        if (0u == (byte & 0x80u))
+        {
+            if (result > UINT32_MAX)
+            {
+                return -1;
+            }
+            *value = (uint32_t)result;
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+
+/*******************************************************************************
+* Function Name: capture_bitmap
+********************************************************************************
+* Summary:
+*  Applies the changed bytes of a bitmap to bitmap. Returns 0 on success.
+*
+*******************************************************************************/
+static int capture_bitmap(fss_capture_decoder_t *decoder, uint8_t *bitmap)
+{
+    uint32_t mask;
+
+    if (0 != capture_varint(decoder, &mask))
+    {
+        return -1;
+    }
+
+    for (uint32_t byte = 0u; byte < FSS_CAPTURE_BITMAP_BYTES; byte++)
+    {
+        if (0u != ((mask >> byte) & 1u))
+        {
+            if (decoder->offset >= decoder->size)
+            {
+                return -1;
+            }
+            bitmap[byte] ^= decoder->data[decoder->offset++];
+        }
+    }
+
+    return 0;
+}
+
+
+/*******************************************************************************
+* Function Name: fss_capture_init
+********************************************************************************
+* Summary:
+*  Starts decoding the bytes drained from the capture ring, in order.
+*
+*******************************************************************************/
+void fss_capture_init(fss_capture_decoder_t *decoder, const uint8_t *data, size_t size)
+{
+    memset(decoder, 0, sizeof(*decoder));
+    decoder->data = data;
+    decoder->size = size;
+}
+
+
+/*******************************************************************************
+* Function Name: fss_capture_next
+********************************************************************************
+* Summary:
+*  Decodes the next record. Returns 1 for a record, 0 at the end of the data
+*  and -1 for a truncated or malformed record.
+*
+*******************************************************************************/
+int fss_capture_next(fss_capture_decoder_t *decoder, fss_capture_record_t *record)
+{
+    uint32_t header;
+
+    if (decoder->offset >= decoder->size)
+    {
+        return 0;
+    }
+    if (0 != capture_varint(decoder, &header))
+    {
+        return -1;
+    }
+
+    record->frames = header >> CAPSENSE_CAPTURE_DELTA_SHIFT;
+    record->key = (0u != (header & CAPSENSE_CAPTURE_KEY));
+    if (record->key)
+    {
+        memset(decoder->raw, 0, sizeof(decoder->raw));
+        memset(decoder->suppressed, 0, sizeof(decoder->suppressed));
+    }
+
+    if ((0u == record->frames) || (0 != capture_bitmap(decoder, decoder->raw)) ||
+        ((0u != (header & CAPSENSE_CAPTURE_SUPPRESSED)) && (0 != capture_bitmap(decoder, decoder->suppressed))))
+    {
+        return -1;
+    }
+
+    for (uint32_t byte = 0u; byte < FSS_CAPTURE_BITMAP_BYTES; byte++)
+    {
+        record->raw[byte] = decoder->raw[byte];
+        record->fss[byte] = (uint8_t)(decoder->raw[byte] & ~decoder->suppressed[byte]);
+    }
+
+    return 1;
+}
+
+
+/* [] END OF FILE */
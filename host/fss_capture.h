@@ -0,0 +1,90 @@
+/******************************************************************************
+* File Name: fss_capture.h
+*
+* Description: Decoder of the touch trace capture of capsense_capture.c for
+*              the host harness.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef FSS_CAPTURE_H
+#define FSS_CAPTURE_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Bytes of a decoded bitmap: up to 256 button sensors */
+#define FSS_CAPTURE_BITMAP_BYTES   (32u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* A decoded record: the status from its frame on. Byte N of a bitmap holds
+ * sensors 8N to 8N + 7.
+ */
+typedef struct
+{
+    uint32_t frames;                            /* Frames since the last record */
+    bool key;                                   /* Records were dropped before it */
+    uint8_t raw[FSS_CAPTURE_BITMAP_BYTES];      /* Status before FSS */
+    uint8_t fss[FSS_CAPTURE_BITMAP_BYTES];      /* Status after FSS */
+} fss_capture_record_t;
+
+typedef struct
+{
+    const uint8_t *data;
+    size_t size;
+    size_t offset;
+    uint8_t raw[FSS_CAPTURE_BITMAP_BYTES];
+    uint8_t suppressed[FSS_CAPTURE_BITMAP_BYTES];
+} fss_capture_decoder_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void fss_capture_init(fss_capture_decoder_t *decoder, const uint8_t *data, size_t size);
+int  fss_capture_next(fss_capture_decoder_t *decoder, fss_capture_record_t *record);
+
+#endif /* FSS_CAPTURE_H */
+
+
+/* [] END OF FILE */
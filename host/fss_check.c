@@ -0,0 +1,406 @@
+/******************************************************************************
+* File Name: fss_check.c
+*
+* Description: Compares FSS with the reference model of fss_reference.c,
+*              frame by frame, on every panel size up to the one of the
+*              build, with one group, with groups and with neighbour tables,
+*              over the synthetic sequences and the recorded traces. Every
+*              build of the Makefile checks one combination of the
+*              compile-time options of capsense_fss_algorithm.h.
+*
+* Related Document: See README.md
+*
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "cycfg_capsense.h"
+#include "capsense_fss_algorithm.h"
+#include "fss_bitops.h"
+#include "fss_reference.h"
+#include "fss_trace.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define CHECK_DEFAULT_FRAMES       (2000u)
+
+/* Mismatches printed in full */
+#define CHECK_PRINT_LIMIT          (10u)
+
+/* Every CHECK_REPEAT_PERIOD frames, the frame is run again, which takes the
+ * path of capsense_fss() that reuses the last result
+ */
+#define CHECK_REPEAT_PERIOD        (3u)
+
+/* Difference counts given to the touched buttons, from 1 to this */
+#define CHECK_DIFF_SPREAD          (8u)
+
+#if (FSS_ARRIVAL_ORDER != 0u)
+#define CHECK_MAX_WINNERS          (FSS_MAX_WINNERS)
+#else
+#define CHECK_MAX_WINNERS          (1u)
+#endif
+
+#if (HOST_BUTTON_SENSOR_COUNT > FSS_REFERENCE_MAX_SENSORS)
+#error "The reference model is too small for the panel"
+#endif
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef enum
+{
+    CHECK_ONE_GROUP,            /* All buttons in one group, from capsense_fss_init() */
+    CHECK_GROUPS,               /* Random groups with gaps and disabled buttons */
+    CHECK_NEIGHBOURS,           /* Random neighbours and disabled buttons */
+    CHECK_LAYOUT_COUNT
+} check_layout_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const char * const check_layout_name[CHECK_LAYOUT_COUNT] = { "one group", "groups", "neighbours" };
+
+static fss_reference_t check_ref;
+static fss_bitmap_t check_neighbours[HOST_BUTTON_SENSOR_COUNT];
+static uint32_t check_random = 1u;
+static uint32_t check_failures;
+
+/*******************************************************************************
+* Function Name: check_next_random
+********************************************************************************
+* Summary:
+*  Returns the next number of a xorshift sequence.
+*
+*******************************************************************************/
+static uint32_t check_next_random(void)
+{
+    check_random ^= check_random << 13;
+    check_random ^= check_random >> 17;
+    check_random ^= check_random << 5;
+    return check_random;
+}
+
+
+/*******************************************************************************
+* Function Name: check_bit
+********************************************************************************
+* Summary:
+*  Returns the bit of a button in an FSS bitmap.
+*
+*******************************************************************************/
+static uint8_t check_bit(const fss_bitmap_t *bitmap, uint32_t sensor)
+{
+    return (uint8_t)((bitmap->word[sensor / FSS_WORD_BITS] >> (sensor % FSS_WORD_BITS)) & 1u);
+}
+
+
+/*******************************************************************************
+* Function Name: check_setup
+********************************************************************************
+* Summary:
+*  Builds a panel of sensors buttons and loads the same layout in FSS and in
+*  the model, then runs a frame with no touch so that FSS starts from a
+*  clean state.
+*
+*******************************************************************************/
+static void check_setup(uint32_t sensors, check_layout_t layout)
+{
+    static const uint8_t released[HOST_BUTTON_SENSOR_COUNT];
+    fss_group_t groups[FSS_MAX_GROUP_COUNT];
+    fss_bitmap_t enabled;
+    uint8_t result[HOST_BUTTON_SENSOR_COUNT];
+    uint8_t groupCount = 0u;
+    uint32_t sensor;
+
+    host_capsense_init_panel(sensors);
+    capsense_fss_init();
+    fss_reference_init(&check_ref, sensors, CHECK_MAX_WINNERS,
+                       (FSS_ARRIVAL_ORDER != 0u), (FSS_DIFF_ARBITRATION != 0u));
+
+    if (CHECK_ONE_GROUP != layout)
+    {
+        /* A quarter of the buttons without FSS */
+        memset(&enabled, 0, sizeof(enabled));
+        for (sensor = 0u; sensor < sensors; sensor++)
+        {
+            bool on = (0u != (check_next_random() % 4u));
+
+            enabled.word[sensor / FSS_WORD_BITS] |= (fss_word_t)on << (sensor % FSS_WORD_BITS);
+            fss_reference_set_enabled(&check_ref, sensor, on);
+        }
+        capsense_fss_set_enable_mask(&enabled);
+
+        /* Groups of up to 6 buttons, or up to 40, with gaps of up to 2 */
+        fss_reference_set_group(&check_ref, 0u, sensors, FSS_REFERENCE_NO_GROUP);
+        sensor = check_next_random() % 3u;
+        while ((sensor < sensors) && (groupCount < FSS_MAX_GROUP_COUNT))
+        {
+            uint32_t count = 1u + (check_next_random() % ((0u != (check_next_random() & 1u)) ? 6u : 40u));
+
+            if ((sensor + count) > sensors)
+            {
+                count = sensors - sensor;
+            }
+            groups[groupCount].firstSensor = (uint8_t)sensor;
+            groups[groupCount].sensorCount = (uint8_t)count;
+            fss_reference_set_group(&check_ref, sensor, count, groupCount);
+            groupCount++;
+            sensor += count + (check_next_random() % 3u);
+        }
+        if (!capsense_fss_set_groups(groups, groupCount))
+        {
+            printf("FAIL: %u groups of %u buttons rejected\n", (unsigned)groupCount, (unsigned)sensors);
+            check_failures++;
+        }
+    }
+
+    if (CHECK_NEIGHBOURS == layout)
+    {
+        /* Runs of neighbours, and a few far apart */
+        memset(check_neighbours, 0, sizeof(check_neighbours));
+        fss_reference_use_neighbours(&check_ref);
+        for (sensor = 0u; sensor < sensors; sensor++)
+        {
+            for (uint32_t other = sensor + 1u; other < sensors; other++)
+            {
+                if ((((other - sensor) <= 2u) && (0u != (check_next_random() & 1u))) ||
+                    (0u == (check_next_random() % 16u)))
+                {
+                    check_neighbours[sensor].word[other / FSS_WORD_BITS] |= (fss_word_t)1u << (other % FSS_WORD_BITS);
+                    check_neighbours[other].word[sensor / FSS_WORD_BITS] |= (fss_word_t)1u << (sensor % FSS_WORD_BITS);
+                    fss_reference_set_neighbours(&check_ref, sensor, other);
+                }
+            }
+        }
+        if (!capsense_fss_set_neighbours(check_neighbours, (uint8_t)sensors))
+        {
+            printf("FAIL: neighbour table of %u buttons rejected\n", (unsigned)sensors);
+            check_failures++;
+        }
+    }
+
+    host_capsense_set_buttons(released);
+    capsense_fss();
+    fss_reference_frame(&check_ref, released, NULL, result);
+}
+
+
+/*******************************************************************************
+* Function Name: check_frame
+********************************************************************************
+* Summary:
+*  Runs one frame through FSS and the model and compares the status after
+*  FSS, the raw and changed bitmaps and the winner, and checks that no
+*  sensor beyond the panel is active. Returns the number of mismatches.
+*
+*******************************************************************************/
+static uint32_t check_frame(uint32_t sensors, const uint8_t *touch, const uint16_t *diff,
+                            uint8_t *previous)
+{
+    uint8_t expected[HOST_BUTTON_SENSOR_COUNT];
+    uint8_t result[HOST_BUTTON_SENSOR_COUNT];
+    const fss_bitmap_t *raw;
+    const fss_bitmap_t *status;
+    const fss_bitmap_t *changed;
+    uint32_t mismatches = 0u;
+
+    host_capsense_set_buttons(touch);
+    capsense_fss();
+    host_capsense_get_buttons(result);
+    fss_reference_frame(&check_ref, touch, diff, expected);
+
+    raw = capsense_fss_get_raw_status();
+    status = capsense_fss_get_status();
+    changed = capsense_fss_get_changed();
+
+    for (uint32_t sensor = 0u; sensor < sensors; sensor++)
+    {
+        uint8_t touched = (0u != touch[sensor]) ? 1u : 0u;
+
+        if ((result[sensor] != expected[sensor]) ||
+            (check_bit(status, sensor) != expected[sensor]) ||
+            (capsense_fss_is_active((uint8_t)sensor) != (0u != expected[sensor])) ||
+            (check_bit(raw, sensor) != touched) ||
+            (check_bit(changed, sensor) != (expected[sensor] ^ previous[sensor])))
+        {
+            mismatches++;
+        }
+        previous[sensor] = expected[sensor];
+    }
+
+    /* Bits beyond the panel, up to the last byte index, are never active */
+    for (uint32_t sensor = sensors; sensor <= UINT8_MAX; sensor++)
+    {
+        mismatches += capsense_fss_is_active((uint8_t)sensor) ? 1u : 0u;
+    }
+
+    if (capsense_fss_get_winner() != fss_reference_winner(&check_ref))
+    {
+        mismatches++;
+    }
+
+    return mismatches;
+}
+
+
+/*******************************************************************************
+* Function Name: check_run
+********************************************************************************
+* Summary:
+*  Replays a trace through FSS and the model on a panel of sensors buttons
+*  with the given layout, giving every touched button a random difference
+*  count. Returns the frames run.
+*
+*******************************************************************************/
+static uint32_t check_run(const char *name, const fss_trace_t *trace, uint32_t sensors, check_layout_t layout)
+{
+    uint8_t touch[HOST_BUTTON_SENSOR_COUNT] = {0};
+    uint16_t diff[HOST_BUTTON_SENSOR_COUNT];
+    uint8_t previous[HOST_BUTTON_SENSOR_COUNT] = {0};
+    uint32_t frames = 0u;
+
+    check_setup(sensors, layout);
+
+    for (uint32_t frame = 0u; frame < trace->frames; frame++)
+    {
+        const uint8_t *raw = fss_trace_frame(trace, frame);
+        uint32_t runs = (0u == (frame % CHECK_REPEAT_PERIOD)) ? 2u : 1u;
+
+        for (uint32_t run = 0u; run < runs; run++)
+        {
+            uint32_t mismatches;
+
+            /* The mock difference count grows with the touch byte */
+            for (uint32_t sensor = 0u; sensor < sensors; sensor++)
+            {
+                touch[sensor] = (0u != raw[sensor]) ? (uint8_t)(1u + (check_next_random() % CHECK_DIFF_SPREAD)) : 0u;
+                diff[sensor] = touch[sensor];
+            }
+
+            mismatches = check_frame(sensors, touch, diff, previous);
+            if (0u != mismatches)
+            {
+                if (check_failures < CHECK_PRINT_LIMIT)
+                {
+                    printf("FAIL %s: %u buttons, %s, frame %u%s: %u mismatches\n", name, (unsigned)sensors,
+                           check_layout_name[layout], (unsigned)frame, (0u != run) ? " again" : "",
+                           (unsigned)mismatches);
+                }
+                check_failures++;
+            }
+            frames++;
+        }
+    }
+
+    return frames;
+}
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Checks every panel size from 1 to HOST_BUTTON_SENSOR_COUNT with every
+*  layout, over the synthetic sequences and the traces given.
+*
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+    uint32_t length = CHECK_DEFAULT_FRAMES;
+    uint64_t frames[CHECK_LAYOUT_COUNT] = {0};
+    fss_trace_t trace;
+    int opt;
+
+    while (-1 != (opt = getopt(argc, argv, "n:")))
+    {
+        switch (opt)
+        {
+            case 'n':
+                length = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-n frames] [trace ...]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    printf("FSS against the reference model: %u status words, ctz method %u, %s, %u winner(s) per group, %s\n",
+           (unsigned)FSS_WORD_COUNT, (unsigned)FSS_CTZ_METHOD,
+           (FSS_ARRIVAL_ORDER != 0u) ? ((FSS_DIFF_ARBITRATION != 0u) ? "arrival then difference order" :
+                                                                      "arrival order") :
+           ((FSS_DIFF_ARBITRATION != 0u) ? "difference order" : "lowest first"),
+           (unsigned)CHECK_MAX_WINNERS,
+           (FSS_STATUS_WRITE_BACK != 0u) ? "status written back" : "result bitmap only");
+
+    for (uint32_t sensors = 1u; sensors <= HOST_BUTTON_SENSOR_COUNT; sensors++)
+    {
+        for (uint32_t layout = 0u; layout < CHECK_LAYOUT_COUNT; layout++)
+        {
+            for (uint32_t scenario = 0u; scenario < FSS_TRACE_SCENARIO_COUNT; scenario++)
+            {
+                fss_trace_synthesize(&trace, sensors, (fss_trace_scenario_t)scenario, length, sensors + layout);
+                frames[layout] += check_run(fss_trace_scenario_name((fss_trace_scenario_t)scenario),
+                                            &trace, sensors, (check_layout_t)layout);
+                fss_trace_free(&trace);
+            }
+
+            for (int arg = optind; arg < argc; arg++)
+            {
+                if (0 != fss_trace_load(&trace, sensors, argv[arg]))
+                {
+                    fprintf(stderr, "%s: cannot read trace\n", argv[arg]);
+                    return EXIT_FAILURE;
+                }
+                frames[layout] += check_run(argv[arg], &trace, sensors, (check_layout_t)layout);
+                fss_trace_free(&trace);
+            }
+        }
+    }
+
+    for (uint32_t layout = 0u; layout < CHECK_LAYOUT_COUNT; layout++)
+    {
+        printf("%-12s 1 to %3u buttons %10llu frames\n", check_layout_name[layout],
+               (unsigned)HOST_BUTTON_SENSOR_COUNT, (unsigned long long)frames[layout]);
+    }
+    printf("%s\n", (0u == check_failures) ? "PASS" : "FAIL");
+
+    return (0u == check_failures) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,311 @@
+/******************************************************************************
+* File Name: fss_reference.c
+*
+* Description: Reference model of FSS for the host harness. Every frame, the
+*              selection of the last frame is kept while its buttons are
+*              still touched, and the free selections go to the touched
+*              buttons in order, as the original fss_algorithm() did for one
+*              winner, one button at a time.
+*
+* Related Document: See README.md
+*
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <string.h>
+#include "fss_reference.h"
+
+/*******************************************************************************
+* Function Name: fss_reference_init
+********************************************************************************
+* Summary:
+*  Sets up the model of a panel of sensors buttons, all with FSS and in one
+*  group, with no button touched. Up to maxWinners buttons are selected in a
+*  group; the free selections go to the buttons touched first with
+*  arrivalOrder, then to the one with the higher difference count with
+*  diffOrder, then to the lowest one.
+*
+*******************************************************************************/
+void fss_reference_init(fss_reference_t *ref, uint32_t sensors, uint32_t maxWinners,
+                        bool arrivalOrder, bool diffOrder)
+{
+    memset(ref, 0, sizeof(*ref));
+    ref->sensors = sensors;
+    ref->maxWinners = maxWinners;
+    ref->arrivalOrder = arrivalOrder;
+    ref->diffOrder = diffOrder;
+    memset(ref->enabled, 1, sizeof(ref->enabled));
+}
+
+
+/*******************************************************************************
+* Function Name: fss_reference_set_group
+********************************************************************************
+* Summary:
+*  Puts count buttons from first in a group, or in no group at all with
+*  FSS_REFERENCE_NO_GROUP: then FSS does not apply to them.
+*
+*******************************************************************************/
+void fss_reference_set_group(fss_reference_t *ref, uint32_t first, uint32_t count, uint8_t group)
+{
+    for (uint32_t sensor = first; (sensor < (first + count)) && (sensor < ref->sensors); sensor++)
+    {
+        ref->group[sensor] = group;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: fss_reference_use_neighbours
+********************************************************************************
+* Summary:
+*  Makes the neighbours decide the selection instead of the groups, as a
+*  neighbour table does, even one with no neighbours at all.
+*
+*******************************************************************************/
+void fss_reference_use_neighbours(fss_reference_t *ref)
+{
+    ref->neighbourMode = true;
+}
+
+
+/*******************************************************************************
+* Function Name: fss_reference_set_neighbours
+********************************************************************************
+* Summary:
+*  Makes two buttons neighbours.
+*
+*******************************************************************************/
+void fss_reference_set_neighbours(fss_reference_t *ref, uint32_t sensor, uint32_t other)
+{
+    ref->neighbour[sensor][other] = 1u;
+    ref->neighbour[other][sensor] = 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: fss_reference_set_enabled
+********************************************************************************
+* Summary:
+*  Applies FSS to a button or not.
+*
+*******************************************************************************/
+void fss_reference_set_enabled(fss_reference_t *ref, uint32_t sensor, bool enabled)
+{
+    ref->enabled[sensor] = enabled ? 1u : 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: fss_reference_member
+********************************************************************************
+* Summary:
+*  Returns true if FSS applies to a button: it is enabled and, without
+*  neighbours, in a group.
+*
+*******************************************************************************/
+static bool fss_reference_member(const fss_reference_t *ref, uint32_t sensor)
+{
+    return (0u != ref->enabled[sensor]) &&
+           (ref->neighbourMode || (FSS_REFERENCE_NO_GROUP != ref->group[sensor]));
+}
+
+
+/*******************************************************************************
+* Function Name: fss_reference_next
+********************************************************************************
+* Summary:
+*  Returns the candidate to select first, scanning the buttons from the
+*  lowest, or FSS_REFERENCE_MAX_SENSORS if there is none.
+*
+*******************************************************************************/
+static uint32_t fss_reference_next(const fss_reference_t *ref, const uint8_t *candidate,
+                                   const uint16_t *diff)
+{
+    uint32_t next = FSS_REFERENCE_MAX_SENSORS;
+
+    for (uint32_t sensor = 0u; sensor < ref->sensors; sensor++)
+    {
+        if (0u == candidate[sensor])
+        {
+            continue;
+        }
+        if (FSS_REFERENCE_MAX_SENSORS == next)
+        {
+            next = sensor;
+        }
+        else if (ref->arrivalOrder && (ref->arrival[sensor] != ref->arrival[next]))
+        {
+            if (ref->arrival[sensor] < ref->arrival[next])
+            {
+                next = sensor;
+            }
+        }
+        else if (ref->diffOrder && (diff[sensor] > diff[next]))
+        {
+            next = sensor;
+        }
+    }
+
+    return next;
+}
+
+
+/*******************************************************************************
+* Function Name: fss_reference_frame
+********************************************************************************
+* Summary:
+*  Runs the model on one frame: touch[] and diff[] hold the touch status and
+*  the difference count of every button (diff may be NULL without diffOrder),
+*  and result[] gets the status after FSS.
+*
+*  A selected button that is still touched stays selected. Without
+*  neighbours, the free selections of every group, up to maxWinners less the
+*  buttons kept, go to its other touched buttons in order. With neighbours,
+*  a touched button is selected in order unless a neighbour is selected.
+*  Buttons without FSS keep their touch status.
+*
+*******************************************************************************/
+void fss_reference_frame(fss_reference_t *ref, const uint8_t *touch, const uint16_t *diff,
+                         uint8_t *result)
+{
+    uint8_t candidate[FSS_REFERENCE_MAX_SENSORS];
+    uint32_t winners[FSS_REFERENCE_NO_GROUP];
+    uint32_t sensor;
+
+    memset(winners, 0, sizeof(winners));
+
+    for (sensor = 0u; sensor < ref->sensors; sensor++)
+    {
+        uint8_t touched = (0u != touch[sensor]) ? 1u : 0u;
+
+        /* A touch starting in this frame arrives after all earlier ones */
+        if ((0u != touched) && (0u == ref->touch[sensor]))
+        {
+            ref->arrival[sensor] = ref->frame;
+        }
+        ref->touch[sensor] = touched;
+
+        if (fss_reference_member(ref, sensor))
+        {
+            result[sensor] = touched & ref->selected[sensor];
+            if ((0u != result[sensor]) && !ref->neighbourMode)
+            {
+                winners[ref->group[sensor]]++;
+            }
+        }
+        else
+        {
+            result[sensor] = touched;
+        }
+    }
+
+    /* The touched buttons that can still be selected */
+    for (sensor = 0u; sensor < ref->sensors; sensor++)
+    {
+        candidate[sensor] = (uint8_t)(fss_reference_member(ref, sensor) &&
+                                      (0u != ref->touch[sensor]) && (0u == result[sensor]));
+    }
+    if (ref->neighbourMode)
+    {
+        for (sensor = 0u; sensor < ref->sensors; sensor++)
+        {
+            for (uint32_t other = 0u; (0u != candidate[sensor]) && (other < ref->sensors); other++)
+            {
+                if ((0u != ref->neighbour[sensor][other]) && fss_reference_member(ref, other) &&
+                    (0u != result[other]))
+                {
+                    candidate[sensor] = 0u;
+                }
+            }
+        }
+    }
+
+    for (;;)
+    {
+        sensor = fss_reference_next(ref, candidate, diff);
+        if (FSS_REFERENCE_MAX_SENSORS == sensor)
+        {
+            break;
+        }
+        candidate[sensor] = 0u;
+
+        if (ref->neighbourMode)
+        {
+            result[sensor] = 1u;
+            for (uint32_t other = 0u; other < ref->sensors; other++)
+            {
+                if (0u != ref->neighbour[sensor][other])
+                {
+                    candidate[other] = 0u;
+                }
+            }
+        }
+        else if (winners[ref->group[sensor]] < ref->maxWinners)
+        {
+            result[sensor] = 1u;
+            winners[ref->group[sensor]]++;
+        }
+    }
+
+    for (sensor = 0u; sensor < ref->sensors; sensor++)
+    {
+        ref->selected[sensor] = result[sensor];
+    }
+    ref->frame++;
+}
+
+
+/*******************************************************************************
+* Function Name: fss_reference_winner
+********************************************************************************
+* Summary:
+*  Returns the lowest button selected in the last frame among those with
+*  FSS, or FSS_REFERENCE_NO_WINNER.
+*
+*******************************************************************************/
+uint8_t fss_reference_winner(const fss_reference_t *ref)
+{
+    for (uint32_t sensor = 0u; sensor < ref->sensors; sensor++)
+    {
+        if ((0u != ref->selected[sensor]) && fss_reference_member(ref, sensor))
+        {
+            return (uint8_t)sensor;
+        }
+    }
+
+    return FSS_REFERENCE_NO_WINNER;
+}
+
+
+/* [] END OF FILE */
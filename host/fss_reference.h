@@ -0,0 +1,99 @@
+/******************************************************************************
+* File Name: fss_reference.h
+*
+* Description: Reference model of FSS for the host harness: the selection
+*              rules written out one button at a time, after the single
+*              winner loop of the original fss_algorithm(), with none of the
+*              bitmaps, masks or caches of capsense_fss_algorithm.c, so that
+*              its output can be compared with FSS frame by frame.
+*
+* Related Document: See README.md
+*
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef FSS_REFERENCE_H
+#define FSS_REFERENCE_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Largest panel of the model */
+#define FSS_REFERENCE_MAX_SENSORS  (128u)
+
+/* Group of a button in no group, and winner when no button is selected */
+#define FSS_REFERENCE_NO_GROUP     (0xFFu)
+#define FSS_REFERENCE_NO_WINNER    (0xFFu)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    /* Configuration */
+    uint32_t sensors;                                       /* Buttons of the panel */
+    uint32_t maxWinners;                                    /* Selections per group */
+    bool arrivalOrder;                                      /* Touched first, selected first */
+    bool diffOrder;                                         /* Then the higher difference count */
+    bool neighbourMode;                                     /* Neighbours instead of groups */
+    uint8_t enabled[FSS_REFERENCE_MAX_SENSORS];             /* FSS applies to the button */
+    uint8_t group[FSS_REFERENCE_MAX_SENSORS];               /* Group of the button */
+    uint8_t neighbour[FSS_REFERENCE_MAX_SENSORS][FSS_REFERENCE_MAX_SENSORS];
+
+    /* State */
+    uint32_t frame;                                         /* Frames so far */
+    uint8_t touch[FSS_REFERENCE_MAX_SENSORS];               /* Touch of the last frame */
+    uint8_t selected[FSS_REFERENCE_MAX_SENSORS];            /* Result of the last frame */
+    uint32_t arrival[FSS_REFERENCE_MAX_SENSORS];            /* Frame where the touch started */
+} fss_reference_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void fss_reference_init(fss_reference_t *ref, uint32_t sensors, uint32_t maxWinners,
+                        bool arrivalOrder, bool diffOrder);
+void fss_reference_set_group(fss_reference_t *ref, uint32_t first, uint32_t count, uint8_t group);
+void fss_reference_use_neighbours(fss_reference_t *ref);
+void fss_reference_set_neighbours(fss_reference_t *ref, uint32_t sensor, uint32_t other);
+void fss_reference_set_enabled(fss_reference_t *ref, uint32_t sensor, bool enabled);
+void fss_reference_frame(fss_reference_t *ref, const uint8_t *touch, const uint16_t *diff,
+                         uint8_t *result);
+uint8_t fss_reference_winner(const fss_reference_t *ref);
+
+#endif /* FSS_REFERENCE_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,953 @@
+/******************************************************************************
+* File Name: fss_replay.c
+*
+* Description: Offline replay of fleet touch logs through the flanking
+*              sensor suppression (FSS) algorithm. Recorded traces of many
+*              devices are replayed through capsense_fss() against the mock
+*              CAPSENSE context, one device per shard on all cores, and the
+*              suppression statistics of every device are reported.
+*
+*              Fleet trace file format: the recorded trace format of
+*              fss_trace.c, split into devices by header lines:
+*                  device <id>
+*              Entries before the first header belong to a device named
+*              after the file, so a plain trace file is a single device.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <ctype.h>
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include "capsense_fss_algorithm.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define REPLAY_DEVICE_KEYWORD      "device"
+#define REPLAY_DEVICE_LENGTH       (48u)
+#define REPLAY_INITIAL_SHARDS      (256u)
+#define REPLAY_MAX_WORKERS         (256u)
+
+/* The files are indexed in parts of this many bytes, one per worker at a
+ * time
+ */
+#define REPLAY_INDEX_PART          (16u * 1024u * 1024u)
+
+/* Shortest header line: the keyword, a space and a one-character id */
+#define REPLAY_HEADER_MIN          (sizeof(REPLAY_DEVICE_KEYWORD) + 1u)
+#define REPLAY_PART_HEADERS        ((REPLAY_INDEX_PART / REPLAY_HEADER_MIN) + 1u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* The entries of one device in a mapped trace file */
+typedef struct
+{
+    const char *begin;
+    const char *end;
+    uint64_t line;                          /* Line number of begin in its file */
+    const char *path;
+    char device[REPLAY_DEVICE_LENGTH];
+} replay_shard_t;
+
+/* A mapped trace file */
+typedef struct
+{
+    const char *path;
+    const char *data;
+    size_t size;
+} replay_file_t;
+
+/* A part of a mapped trace file, indexed by one worker */
+typedef struct
+{
+    uint32_t file;
+    size_t begin;
+    size_t end;
+} replay_part_t;
+
+/* A device header found in a part: the start of its line, relative to the
+ * part, and the line ends of the part before it
+ */
+typedef struct
+{
+    uint32_t offset;
+    uint32_t newlines;
+} replay_header_t;
+
+/* What the index found in one part */
+typedef struct
+{
+    uint32_t newlines;                      /* Line ends in the part */
+    uint32_t headers;                       /* Headers found */
+} replay_part_index_t;
+
+/* Shared by the index workers: the dispatch counter and what they found */
+typedef struct
+{
+    uint32_t next;
+    replay_part_index_t part[];
+} replay_index_shared_t;
+
+/* Suppression statistics of one device */
+typedef struct
+{
+    uint64_t frames;
+    uint64_t touches;                       /* Raw touches started */
+    uint64_t suppressed;                    /* Touches suppressed for at least one frame */
+    uint64_t selections;                    /* Buttons turned on by FSS */
+    uint64_t dwellFrames;                   /* Frames the buttons stayed on, in total */
+    uint64_t dwellMax;                      /* Longest time a button stayed on */
+    uint64_t multiFrames;                   /* Frames with two or more raw touches */
+    uint64_t onsets;                        /* Frames where two or more touches start */
+    uint64_t errorLine;                     /* Line of the first malformed entry, or 0 */
+    uint64_t wideLine;                      /* Line of the first entry wider than the panel, or 0 */
+} replay_stats_t;
+
+/* Shared by all workers: the dispatch counter and the statistics */
+typedef struct
+{
+    uint32_t next;
+    replay_stats_t stats[];
+} replay_shared_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static replay_file_t *files;
+static uint32_t file_count;
+
+static replay_part_t *parts;
+static uint32_t part_count;
+static replay_index_shared_t *index_shared;
+static replay_header_t *part_headers;       /* REPLAY_PART_HEADERS per part */
+
+static replay_shard_t *shards;
+static uint32_t shard_count;
+static uint32_t shard_capacity;
+static uint32_t *shard_order;               /* Largest shard first */
+static replay_shared_t *shared;
+
+/* Number of consecutive sensors per FSS group, 0 for the built-in table */
+static uint32_t group_size;
+
+/*******************************************************************************
+* Function Name: now_ns
+********************************************************************************
+* Summary:
+*  Returns the monotonic clock in nanoseconds.
+*
+*******************************************************************************/
+static inline uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000u) + (uint64_t)ts.tv_nsec;
+}
+
+
+/*******************************************************************************
+* Function Name: replay_add_shard
+********************************************************************************
+* Summary:
+*  Appends a shard for the entries of device that start at begin.
+*
+*******************************************************************************/
+static replay_shard_t *replay_add_shard(const char *path, const char *device, size_t length,
+                                        const char *begin, uint64_t line)
+{
+    replay_shard_t *shard;
+
+    if (shard_count == shard_capacity)
+    {
+        shard_capacity = (0u == shard_capacity) ? REPLAY_INITIAL_SHARDS : (shard_capacity * 2u);
+        shards = realloc(shards, (size_t)shard_capacity * sizeof(shards[0]));
+        if (NULL == shards)
+        {
+            perror("fss_replay");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    shard = &shards[shard_count++];
+    if (length >= REPLAY_DEVICE_LENGTH)
+    {
+        length = REPLAY_DEVICE_LENGTH - 1u;
+    }
+    memcpy(shard->device, device, length);
+    shard->device[length] = '\0';
+    shard->path = path;
+    shard->begin = begin;
+    shard->end = begin;
+    shard->line = line;
+    return shard;
+}
+
+
+/*******************************************************************************
+* Function Name: replay_map
+********************************************************************************
+* Summary:
+*  Maps a fleet trace file and splits it into parts of REPLAY_INDEX_PART
+*  bytes for the index workers. Returns 0 on success.
+*
+*******************************************************************************/
+static int replay_map(const char *path)
+{
+    struct stat info;
+    replay_file_t *file;
+    const char *data;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0)
+    {
+        return -1;
+    }
+    if (0 != fstat(fd, &info))
+    {
+        close(fd);
+        return -1;
+    }
+    if (0 == info.st_size)
+    {
+        close(fd);
+        return 0;
+    }
+
+    /* The mapping is inherited by the workers and outlives the descriptor */
+    data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (MAP_FAILED == data)
+    {
+        return -1;
+    }
+    (void)madvise((void *)data, (size_t)info.st_size, MADV_SEQUENTIAL);
+
+    files = realloc(files, ((size_t)file_count + 1u) * sizeof(files[0]));
+    if (NULL == files)
+    {
+        perror("fss_replay");
+        exit(EXIT_FAILURE);
+    }
+    file = &files[file_count];
+    file->path = path;
+    file->data = data;
+    file->size = (size_t)info.st_size;
+
+    for (size_t begin = 0u; begin < file->size; begin += REPLAY_INDEX_PART)
+    {
+        parts = realloc(parts, ((size_t)part_count + 1u) * sizeof(parts[0]));
+        if (NULL == parts)
+        {
+            perror("fss_replay");
+            exit(EXIT_FAILURE);
+        }
+        parts[part_count].file = file_count;
+        parts[part_count].begin = begin;
+        parts[part_count].end = ((file->size - begin) > REPLAY_INDEX_PART) ? (begin + REPLAY_INDEX_PART) : file->size;
+        part_count++;
+    }
+    file_count++;
+
+    return 0;
+}
+
+
+/*******************************************************************************
+* Function Name: replay_header_id
+********************************************************************************
+* Summary:
+*  Returns the start of the device id if the line from text to eol is a
+*  device header, else NULL.
+*
+*******************************************************************************/
+static const char *replay_header_id(const char *text, const char *eol)
+{
+    while ((text < eol) && isspace((unsigned char)*text))
+    {
+        text++;
+    }
+
+    if (((size_t)(eol - text) > strlen(REPLAY_DEVICE_KEYWORD)) &&
+        (0 == memcmp(text, REPLAY_DEVICE_KEYWORD, strlen(REPLAY_DEVICE_KEYWORD))) &&
+        isspace((unsigned char)text[strlen(REPLAY_DEVICE_KEYWORD)]))
+    {
+        const char *id = text + strlen(REPLAY_DEVICE_KEYWORD);
+
+        while ((id < eol) && isspace((unsigned char)*id))
+        {
+            id++;
+        }
+        return id;
+    }
+
+    return NULL;
+}
+
+
+/*******************************************************************************
+* Function Name: replay_index_part
+********************************************************************************
+* Summary:
+*  Finds the device headers of the lines that start in a part and counts
+*  the line ends of the part. The line under way at the start of the part
+*  belongs to the previous part.
+*
+*******************************************************************************/
+static void replay_index_part(uint32_t index)
+{
+    const replay_part_t *part = &parts[index];
+    const replay_file_t *file = &files[part->file];
+    replay_header_t *headers = &part_headers[(size_t)index * REPLAY_PART_HEADERS];
+    const char *begin = file->data + part->begin;
+    const char *partEnd = file->data + part->end;
+    const char *end = file->data + file->size;
+    const char *cursor = begin;
+    uint32_t newlines = 0u;
+    uint32_t count = 0u;
+
+    if ((0u != part->begin) && ('\n' != cursor[-1]))
+    {
+        const char *eol = memchr(cursor, '\n', (size_t)(end - cursor));
+
+        newlines += ((NULL != eol) && (eol < partEnd)) ? 1u : 0u;
+        cursor = (NULL == eol) ? end : (eol + 1);
+    }
+
+    while (cursor < partEnd)
+    {
+        const char *eol = memchr(cursor, '\n', (size_t)(end - cursor));
+
+        eol = (NULL == eol) ? end : eol;
+        if (NULL != replay_header_id(cursor, eol))
+        {
+            headers[count].offset = (uint32_t)(cursor - begin);
+            headers[count].newlines = newlines;
+            count++;
+        }
+        newlines += (eol < partEnd) ? 1u : 0u;
+        cursor = (eol < end) ? (eol + 1) : end;
+    }
+
+    index_shared->part[index].newlines = newlines;
+    index_shared->part[index].headers = count;
+}
+
+
+/*******************************************************************************
+* Function Name: replay_index_worker
+********************************************************************************
+* Summary:
+*  Takes the next part from the shared dispatch counter until none is left.
+*
+*******************************************************************************/
+static void replay_index_worker(void)
+{
+    uint32_t next;
+
+    while ((next = __atomic_fetch_add(&index_shared->next, 1u, __ATOMIC_RELAXED)) < part_count)
+    {
+        replay_index_part(next);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: replay_add_leading
+********************************************************************************
+* Summary:
+*  Adds a device named after the file for the entries before limit, the
+*  first header of the file or its end, if there is one.
+*
+*******************************************************************************/
+static void replay_add_leading(const replay_file_t *file, const char *limit)
+{
+    const char *cursor = file->data;
+
+    for (uint64_t line = 1u; cursor < limit; line++)
+    {
+        const char *eol = memchr(cursor, '\n', (size_t)(limit - cursor));
+        const char *text = cursor;
+
+        eol = (NULL == eol) ? limit : eol;
+        while ((text < eol) && isspace((unsigned char)*text))
+        {
+            text++;
+        }
+        if ((text < eol) && ('#' != *text))
+        {
+            replay_add_shard(file->path, file->path, strlen(file->path), cursor, line)->end = limit;
+            return;
+        }
+        cursor = (eol < limit) ? (eol + 1) : limit;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: replay_index_merge
+********************************************************************************
+* Summary:
+*  Turns the headers found in the parts into one shard per device, in file
+*  order. A device runs from its header to the next one.
+*
+*******************************************************************************/
+static void replay_index_merge(void)
+{
+    uint32_t part = 0u;
+
+    for (uint32_t index = 0u; index < file_count; index++)
+    {
+        const replay_file_t *file = &files[index];
+        const char *end = file->data + file->size;
+        replay_shard_t *shard = NULL;
+        uint64_t newlines = 0u;
+
+        for (; (part < part_count) && (parts[part].file == index); part++)
+        {
+            const replay_header_t *headers = &part_headers[(size_t)part * REPLAY_PART_HEADERS];
+
+            for (uint32_t header = 0u; header < index_shared->part[part].headers; header++)
+            {
+                const char *text = file->data + parts[part].begin + headers[header].offset;
+                const char *eol = memchr(text, '\n', (size_t)(end - text));
+                const char *id;
+                const char *idEnd;
+
+                eol = (NULL == eol) ? end : eol;
+                id = replay_header_id(text, eol);
+                idEnd = eol;
+                while ((idEnd > id) && isspace((unsigned char)idEnd[-1]))
+                {
+                    idEnd--;
+                }
+
+                if (NULL != shard)
+                {
+                    shard->end = text;
+                }
+                else
+                {
+                    replay_add_leading(file, text);
+                }
+
+                /* Entries start on the line after the header */
+                shard = replay_add_shard(file->path, id, (size_t)(idEnd - id), (eol < end) ? (eol + 1) : end,
+                                         newlines + headers[header].newlines + 2u);
+            }
+            newlines += index_shared->part[part].newlines;
+        }
+
+        if (NULL != shard)
+        {
+            shard->end = end;
+        }
+        else
+        {
+            replay_add_leading(file, end);
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: replay_setup
+********************************************************************************
+* Summary:
+*  Resets the mock context and FSS for the next device, and splits the panel
+*  into groups of group_size sensors when requested. FSS then runs one
+*  untouched frame, so that no state of the previous device carries over.
+*
+*******************************************************************************/
+static void replay_setup(void)
+{
+    static const uint8_t untouched[HOST_BUTTON_SENSOR_COUNT] = { 0 };
+    fss_group_t groups[HOST_BUTTON_SENSOR_COUNT];
+    uint32_t count = 0u;
+
+    host_capsense_init();
+    capsense_fss_init();
+
+    if (0u != group_size)
+    {
+        for (uint32_t first = 0u; first < HOST_BUTTON_SENSOR_COUNT; first += group_size)
+        {
+            groups[count].firstSensor = (uint8_t)first;
+            groups[count].sensorCount = (uint8_t)(((first + group_size) <= HOST_BUTTON_SENSOR_COUNT) ?
+                                                  group_size : (HOST_BUTTON_SENSOR_COUNT - first));
+            count++;
+        }
+        (void)capsense_fss_set_groups(groups, (uint8_t)count);
+    }
+
+    host_capsense_set_buttons(untouched);
+    capsense_fss();
+}
+
+
+/*******************************************************************************
+* Function Name: replay_nibble
+********************************************************************************
+* Summary:
+*  Returns the value of a hexadecimal digit.
+*
+*******************************************************************************/
+static inline uint32_t replay_nibble(char c)
+{
+    return (uint32_t)(isdigit((unsigned char)c) ? (c - '0') : (tolower((unsigned char)c) - 'a' + 10));
+}
+
+
+/*******************************************************************************
+* Function Name: replay_shard
+********************************************************************************
+* Summary:
+*  Replays the entries of one device through capsense_fss() and gathers its
+*  statistics. An entry repeats the same raw status, and FSS gives the same
+*  result for an unchanged status, so each entry is run once and counted for
+*  all its frames. A malformed entry, or one with a bit set above the
+*  sensors of the panel, stops the replay of the device.
+*
+*******************************************************************************/
+static void replay_shard(const replay_shard_t *shard, replay_stats_t *stats)
+{
+    uint8_t raw[HOST_BUTTON_SENSOR_COUNT] = { 0 };
+    uint8_t lastRaw[HOST_BUTTON_SENSOR_COUNT] = { 0 };
+    uint8_t out[HOST_BUTTON_SENSOR_COUNT];
+    uint8_t lastOut[HOST_BUTTON_SENSOR_COUNT] = { 0 };
+    uint8_t suppressed[HOST_BUTTON_SENSOR_COUNT] = { 0 };
+    uint64_t dwell[HOST_BUTTON_SENSOR_COUNT] = { 0 };
+    const char *cursor = shard->begin;
+    uint64_t line = shard->line;
+
+    memset(stats, 0, sizeof(*stats));
+    replay_setup();
+
+    for (; cursor < shard->end; line++)
+    {
+        const char *eol = memchr(cursor, '\n', (size_t)(shard->end - cursor));
+        const char *text = cursor;
+        const char *digits;
+        uint64_t repeat = 0u;
+        uint32_t length = 0u;
+        uint32_t active = 0u;
+        uint32_t started = 0u;
+
+        eol = (NULL == eol) ? shard->end : eol;
+        cursor = (eol < shard->end) ? (eol + 1) : shard->end;
+
+        while ((text < eol) && isspace((unsigned char)*text))
+        {
+            text++;
+        }
+        if ((text == eol) || ('#' == *text))
+        {
+            continue;
+        }
+
+        /* <frames> <bitmap>, parsed within the line: the mapping has no
+         * terminating zero
+         */
+        while ((text < eol) && isdigit((unsigned char)*text))
+        {
+            repeat = (repeat * 10u) + (uint64_t)(*text - '0');
+            text++;
+        }
+        while ((text < eol) && isspace((unsigned char)*text))
+        {
+            text++;
+        }
+        digits = text;
+        while (((digits + length) < eol) && isxdigit((unsigned char)digits[length]))
+        {
+            length++;
+        }
+        if ((0u == repeat) || (0u == length))
+        {
+            stats->errorLine = line;
+            return;
+        }
+
+        /* Digits from the one holding the sensor after the last one */
+        for (uint32_t digit = HOST_BUTTON_SENSOR_COUNT / 4u; digit < length; digit++)
+        {
+            uint32_t first = digit * 4u;
+            uint32_t nibble = replay_nibble(digits[length - 1u - digit]);
+
+            if (0u != ((first < HOST_BUTTON_SENSOR_COUNT) ? (nibble >> (HOST_BUTTON_SENSOR_COUNT - first)) : nibble))
+            {
+                stats->wideLine = line;
+                return;
+            }
+        }
+
+        for (uint32_t sensor = 0u; sensor < HOST_BUTTON_SENSOR_COUNT; sensor++)
+        {
+            uint32_t digit = sensor / 4u;
+
+            raw[sensor] = 0u;
+            if (digit < length)
+            {
+                raw[sensor] = (uint8_t)((replay_nibble(digits[length - 1u - digit]) >> (sensor % 4u)) & 1u);
+            }
+        }
+
+        host_capsense_set_buttons(raw);
+        capsense_fss();
+        host_capsense_get_buttons(out);
+
+        for (uint32_t sensor = 0u; sensor < HOST_BUTTON_SENSOR_COUNT; sensor++)
+        {
+            if (0u != raw[sensor])
+            {
+                active++;
+                if (0u == lastRaw[sensor])
+                {
+                    started++;
+                    suppressed[sensor] = 0u;
+                }
+                if ((0u == out[sensor]) && (0u == suppressed[sensor]))
+                {
+                    stats->suppressed++;
+                    suppressed[sensor] = 1u;
+                }
+            }
+
+            if (0u != out[sensor])
+            {
+                if (0u == lastOut[sensor])
+                {
+                    stats->selections++;
+                    dwell[sensor] = 0u;
+                }
+                dwell[sensor] += repeat;
+                stats->dwellFrames += repeat;
+            }
+            else if ((0u != lastOut[sensor]) && (dwell[sensor] > stats->dwellMax))
+            {
+                stats->dwellMax = dwell[sensor];
+            }
+        }
+
+        stats->frames += repeat;
+        stats->touches += started;
+        stats->multiFrames += (active >= 2u) ? repeat : 0u;
+        stats->onsets += (started >= 2u) ? 1u : 0u;
+        memcpy(lastRaw, raw, sizeof(raw));
+        memcpy(lastOut, out, sizeof(out));
+    }
+
+    /* Buttons still on at the end of the log */
+    for (uint32_t sensor = 0u; sensor < HOST_BUTTON_SENSOR_COUNT; sensor++)
+    {
+        if ((0u != lastOut[sensor]) && (dwell[sensor] > stats->dwellMax))
+        {
+            stats->dwellMax = dwell[sensor];
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: replay_worker
+********************************************************************************
+* Summary:
+*  Takes the next shard from the shared dispatch counter until none is left.
+*  The shards are dispatched largest first, so a worker that finishes early
+*  takes over the work that is left instead of waiting on a fixed split.
+*
+*******************************************************************************/
+static void replay_worker(void)
+{
+    uint32_t next;
+
+    while ((next = __atomic_fetch_add(&shared->next, 1u, __ATOMIC_RELAXED)) < shard_count)
+    {
+        replay_shard(&shards[shard_order[next]], &shared->stats[shard_order[next]]);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: replay_fork
+********************************************************************************
+* Summary:
+*  Runs work on that many worker processes and waits for all of them.
+*  Returns non-zero if a worker could not be started or failed.
+*
+*******************************************************************************/
+static int replay_fork(long workers, void (*work)(void))
+{
+    int failed = 0;
+
+    fflush(stdout);
+    for (long worker = 0; worker < workers; worker++)
+    {
+        pid_t pid = fork();
+
+        if (0 == pid)
+        {
+            work();
+            _exit(EXIT_SUCCESS);
+        }
+        if (pid < 0)
+        {
+            perror("fss_replay");
+            failed = 1;
+            break;
+        }
+    }
+    for (;;)
+    {
+        int status;
+
+        if (wait(&status) < 0)
+        {
+            break;
+        }
+        if (!WIFEXITED(status) || (EXIT_SUCCESS != WEXITSTATUS(status)))
+        {
+            failed = 1;
+        }
+    }
+
+    return failed;
+}
+
+
+/*******************************************************************************
+* Function Name: replay_compare_size
+********************************************************************************
+* Summary:
+*  qsort() comparison of two shard indices, the larger shard first.
+*
+*******************************************************************************/
+static int replay_compare_size(const void *a, const void *b)
+{
+    const replay_shard_t *first = &shards[*(const uint32_t *)a];
+    const replay_shard_t *second = &shards[*(const uint32_t *)b];
+    ptrdiff_t firstSize = first->end - first->begin;
+    ptrdiff_t secondSize = second->end - second->begin;
+
+    return (firstSize < secondSize) - (firstSize > secondSize);
+}
+
+
+/*******************************************************************************
+* Function Name: replay_print
+********************************************************************************
+* Summary:
+*  Prints one line of statistics.
+*
+*******************************************************************************/
+static void replay_print(const char *device, const replay_stats_t *stats)
+{
+    printf("%-24.24s %12llu %9llu %10llu %10llu %9.1f %9llu %7.2f%% %8llu\n", device,
+           (unsigned long long)stats->frames, (unsigned long long)stats->touches,
+           (unsigned long long)stats->suppressed, (unsigned long long)stats->selections,
+           (0u != stats->selections) ? ((double)stats->dwellFrames / (double)stats->selections) : 0.0,
+           (unsigned long long)stats->dwellMax,
+           (0u != stats->frames) ? ((100.0 * (double)stats->multiFrames) / (double)stats->frames) : 0.0,
+           (unsigned long long)stats->onsets);
+}
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Usage: fss_replay [-j workers] [-g group size] trace ...
+*  Splits the fleet trace files into devices and replays them on -j worker
+*  processes (one per online CPU by default), then prints the statistics of
+*  every device in file order and their total. The workers first find the
+*  device headers in parts of the files, so that the whole run scales with
+*  the workers. The FSS code keeps its state in file-scope variables, as on
+*  target, so the workers are processes rather than threads; they share the
+*  dispatch counters, the headers found and the statistics.
+*  Every device is replayed from reset. With -g, the panel is split into FSS
+*  groups of that many sensors.
+*
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+    long workers = sysconf(_SC_NPROCESSORS_ONLN);
+    replay_stats_t total;
+    size_t sharedSize;
+    uint64_t start;
+    int failed = 0;
+    int opt;
+
+    while (-1 != (opt = getopt(argc, argv, "j:g:")))
+    {
+        switch (opt)
+        {
+            case 'j':
+                workers = strtol(optarg, NULL, 0);
+                break;
+            case 'g':
+                group_size = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            default:
+                workers = 0;
+                break;
+        }
+    }
+    if ((workers < 1) || (optind == argc))
+    {
+        fprintf(stderr, "usage: %s [-j workers] [-g group size] trace ...\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (workers > (long)REPLAY_MAX_WORKERS)
+    {
+        workers = (long)REPLAY_MAX_WORKERS;
+    }
+
+    start = now_ns();
+    for (int arg = optind; arg < argc; arg++)
+    {
+        if (0 != replay_map(argv[arg]))
+        {
+            fprintf(stderr, "%s: cannot read trace\n", argv[arg]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    /* Finding the device headers of all parts, then the shards */
+    index_shared = mmap(NULL, sizeof(*index_shared) + ((size_t)part_count * sizeof(index_shared->part[0])),
+                        PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    part_headers = mmap(NULL, ((size_t)part_count + 1u) * REPLAY_PART_HEADERS * sizeof(part_headers[0]),
+                        PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if ((MAP_FAILED == index_shared) || (MAP_FAILED == part_headers))
+    {
+        perror("fss_replay");
+        return EXIT_FAILURE;
+    }
+    if ((0 != replay_fork(((long)part_count < workers) ? (long)part_count : workers, replay_index_worker)) ||
+        (index_shared->next < part_count))
+    {
+        fprintf(stderr, "fss_replay: an index worker failed\n");
+        return EXIT_FAILURE;
+    }
+    replay_index_merge();
+
+    if ((long)shard_count < workers)
+    {
+        workers = (0u != shard_count) ? (long)shard_count : 1;
+    }
+
+    shard_order = malloc(((size_t)shard_count + 1u) * sizeof(shard_order[0]));
+    sharedSize = sizeof(*shared) + ((size_t)shard_count * sizeof(shared->stats[0]));
+    shared = mmap(NULL, sharedSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if ((NULL == shard_order) || (MAP_FAILED == shared))
+    {
+        perror("fss_replay");
+        return EXIT_FAILURE;
+    }
+    for (uint32_t shard = 0u; shard < shard_count; shard++)
+    {
+        shard_order[shard] = shard;
+    }
+    qsort(shard_order, shard_count, sizeof(shard_order[0]), replay_compare_size);
+
+    if ((0 != replay_fork(workers, replay_worker)) || (shared->next < shard_count))
+    {
+        fprintf(stderr, "fss_replay: a worker failed\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("panel: %u button sensors, ", (unsigned)HOST_BUTTON_SENSOR_COUNT);
+    if (0u != group_size)
+    {
+        printf("FSS groups of %u sensors\n", group_size);
+    }
+    else
+    {
+        printf("built-in FSS groups\n");
+    }
+    printf("%-24s %12s %9s %10s %10s %9s %9s %8s %8s\n", "device", "frames", "touches",
+           "suppressed", "selections", "dwell avg", "dwell max", "multi", "onsets");
+
+    memset(&total, 0, sizeof(total));
+    for (uint32_t shard = 0u; shard < shard_count; shard++)
+    {
+        const replay_stats_t *stats = &shared->stats[shard];
+
+        if (0u != stats->errorLine)
+        {
+            fprintf(stderr, "%s:%llu: malformed entry, device %s stopped there\n", shards[shard].path,
+                    (unsigned long long)stats->errorLine, shards[shard].device);
+            failed = 1;
+        }
+        if (0u != stats->wideLine)
+        {
+            fprintf(stderr, "%s:%llu: entry wider than the %u sensors of the panel, device %s stopped there\n",
+                    shards[shard].path, (unsigned long long)stats->wideLine, (unsigned)HOST_BUTTON_SENSOR_COUNT,
+                    shards[shard].device);
+            failed = 1;
+        }
+        replay_print(shards[shard].device, stats);
+
+        total.frames += stats->frames;
+        total.touches += stats->touches;
+        total.suppressed += stats->suppressed;
+        total.selections += stats->selections;
+        total.dwellFrames += stats->dwellFrames;
+        total.dwellMax = (stats->dwellMax > total.dwellMax) ? stats->dwellMax : total.dwellMax;
+        total.multiFrames += stats->multiFrames;
+        total.onsets += stats->onsets;
+    }
+    replay_print("total", &total);
+
+    fprintf(stderr, "%u devices, %llu frames in %.3f s on %ld workers\n", shard_count,
+            (unsigned long long)total.frames, (double)(now_ns() - start) / 1e9, workers);
+
+    return (0 != failed) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,925 @@
+/******************************************************************************
+* File Name: fss_search.c
+*
+* Description: Searches the FSS configurations for the trade-off between the
+*              touch latency and the wrong and missed keys. Every candidate
+*              configuration (enable mask, groups or neighbour table,
+*              tie-break and debounce) is run through capsense_fss() against
+*              the mock CAPSENSE context over labelled recorded traces, on
+*              all cores, and the configurations that no other one beats on
+*              all three counts (the Pareto front) are reported.
+*
+*              Labelled trace format: the recorded trace format of
+*              fss_trace.c with the intended buttons of every entry, and
+*              the difference counts of its touched buttons for the
+*              difference count tie-break:
+*                  <frames> <raw bitmap> <intended bitmap> [<counts>]
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <ctype.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "capsense_fss_algorithm.h"
+#include "fss_trace.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SEARCH_MAX_CHOICES         (16u)
+#define SEARCH_MAX_WORKERS         (256u)
+#define SEARCH_MAX_TRACES          (256u)
+#define SEARCH_PATH_LENGTH         (4096u)
+
+/* Room for the name of a build after its directory */
+#define SEARCH_NAME_LENGTH         (32u)
+
+/* The tie-break is chosen at compile time: every build evaluates the
+ * configurations of its own, and the search runs the build of each.
+ */
+#if (FSS_ARRIVAL_ORDER != 0u)
+#if (FSS_MAX_WINNERS != 1u)
+#error "The arrival order build of fss_search keeps one button per group"
+#endif
+#define SEARCH_BUILD_TIE_BREAK     (SEARCH_ARRIVAL)
+#elif (FSS_DIFF_ARBITRATION != 0u)
+#define SEARCH_BUILD_TIE_BREAK     (SEARCH_DIFF)
+#else
+#define SEARCH_BUILD_TIE_BREAK     (SEARCH_LOWEST)
+#endif
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef enum
+{
+    SEARCH_LOWEST,                          /* The lowest button wins */
+    SEARCH_ARRIVAL,                         /* The button touched first wins */
+    SEARCH_DIFF,                            /* The highest difference count wins */
+    SEARCH_TIE_BREAK_COUNT
+} search_tie_break_t;
+
+/* Groups of size consecutive buttons (0 for a single group), or with
+ * neighbours, a row of keys, each the neighbour of the keys up to size
+ * places away
+ */
+typedef struct
+{
+    bool neighbours;
+    uint32_t size;
+} search_grouping_t;
+
+/* Results of one configuration over all the traces */
+typedef struct
+{
+    uint64_t presses;                       /* Intended presses */
+    uint64_t reported;                      /* Presses FSS reported */
+    uint64_t missed;                        /* Presses FSS never reported */
+    uint64_t wrong;                         /* Buttons turned on by FSS without being intended */
+    uint64_t latencySum;                    /* Frames from the press to the report, in total */
+    uint64_t latencyMax;
+} search_stats_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const char * const tie_break_name[SEARCH_TIE_BREAK_COUNT] = { "lowest", "arrival", "diff" };
+static const char * const tie_break_suffix[SEARCH_TIE_BREAK_COUNT] = { "", "_arrival", "_diff" };
+
+static uint32_t tie_breaks[SEARCH_TIE_BREAK_COUNT];
+static uint32_t tie_break_count;
+static fss_bitmap_t masks[SEARCH_MAX_CHOICES];
+static const char *mask_text[SEARCH_MAX_CHOICES];
+static uint32_t mask_count;
+static search_grouping_t groupings[SEARCH_MAX_CHOICES];
+static uint32_t grouping_count;
+static uint32_t debounces[SEARCH_MAX_CHOICES];
+static uint32_t debounce_count;
+
+static fss_trace_t traces[SEARCH_MAX_TRACES];
+static uint32_t trace_count;
+
+/* Configurations per tie-break */
+static uint32_t config_count;
+
+/*******************************************************************************
+* Function Name: now_ns
+********************************************************************************
+* Summary:
+*  Returns the monotonic clock in nanoseconds.
+*
+*******************************************************************************/
+static inline uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000u) + (uint64_t)ts.tv_nsec;
+}
+
+
+/*******************************************************************************
+* Function Name: search_list
+********************************************************************************
+* Summary:
+*  Parses a comma-separated list of numbers into values. Returns the number
+*  of values, or 0 if the list is malformed or too long.
+*
+*******************************************************************************/
+static uint32_t search_list(const char *text, uint32_t *values)
+{
+    uint32_t count = 0u;
+    char *end;
+
+    do
+    {
+        if ((count == SEARCH_MAX_CHOICES) || ('\0' == *text))
+        {
+            return 0u;
+        }
+        values[count++] = (uint32_t)strtoul(text, &end, 0);
+        if ((end == text) || ((',' != *end) && ('\0' != *end)))
+        {
+            return 0u;
+        }
+        text = end + 1;
+    } while (',' == *end);
+
+    return count;
+}
+
+
+/*******************************************************************************
+* Function Name: search_mask
+********************************************************************************
+* Summary:
+*  Parses an enable mask in hex, bit N being the Nth button sensor. Bits
+*  above the number of sensors of the panel are dropped. Returns false if
+*  the mask is malformed.
+*
+*******************************************************************************/
+static bool search_mask(const char *text, fss_bitmap_t *mask)
+{
+    size_t length;
+
+    memset(mask, 0, sizeof(*mask));
+    if ((0 == strncmp(text, "0x", 2u)) || (0 == strncmp(text, "0X", 2u)))
+    {
+        text += 2;
+    }
+    length = strlen(text);
+    if ((0u == length) || (strspn(text, "0123456789abcdefABCDEF") != length))
+    {
+        return false;
+    }
+
+    for (uint32_t sensor = 0u; (sensor < HOST_BUTTON_SENSOR_COUNT) && ((sensor / 4u) < length); sensor++)
+    {
+        char c = text[length - 1u - (sensor / 4u)];
+        uint32_t nibble = (uint32_t)(isdigit((unsigned char)c) ? (c - '0') : (tolower((unsigned char)c) - 'a' + 10));
+
+        if (0u != ((nibble >> (sensor % 4u)) & 1u))
+        {
+            mask->word[sensor / FSS_WORD_BITS] |= (fss_word_t)1u << (sensor % FSS_WORD_BITS);
+        }
+    }
+
+    return true;
+}
+
+
+/*******************************************************************************
+* Function Name: search_tie_break
+********************************************************************************
+* Summary:
+*  Parses a comma-separated list of tie-break names. Returns false if a
+*  name is unknown.
+*
+*******************************************************************************/
+static bool search_tie_break(const char *text)
+{
+    tie_break_count = 0u;
+
+    while ('\0' != *text)
+    {
+        size_t length = strcspn(text, ",");
+        uint32_t tieBreak;
+
+        for (tieBreak = 0u; tieBreak < SEARCH_TIE_BREAK_COUNT; tieBreak++)
+        {
+            if ((strlen(tie_break_name[tieBreak]) == length) &&
+                (0 == strncmp(text, tie_break_name[tieBreak], length)))
+            {
+                break;
+            }
+        }
+        if ((tieBreak == SEARCH_TIE_BREAK_COUNT) || (tie_break_count == SEARCH_TIE_BREAK_COUNT))
+        {
+            return false;
+        }
+        tie_breaks[tie_break_count++] = tieBreak;
+
+        text += length;
+        text += (',' == *text) ? 1 : 0;
+    }
+
+    return (0u != tie_break_count);
+}
+
+
+/*******************************************************************************
+* Function Name: search_setup
+********************************************************************************
+* Summary:
+*  Resets the mock context and FSS and loads the enable mask and the groups
+*  or neighbour table of a configuration. FSS then runs one untouched frame,
+*  so that no state of the previous run carries over.
+*
+*******************************************************************************/
+static void search_setup(const fss_bitmap_t *mask, const search_grouping_t *grouping)
+{
+    static const uint8_t untouched[HOST_BUTTON_SENSOR_COUNT] = { 0 };
+    /* Kept by capsense_fss_set_neighbours() */
+    static fss_bitmap_t neighbours[HOST_BUTTON_SENSOR_COUNT];
+    fss_group_t groups[HOST_BUTTON_SENSOR_COUNT];
+    uint32_t size = (0u != grouping->size) ? grouping->size : HOST_BUTTON_SENSOR_COUNT;
+    uint32_t count = 0u;
+    bool loaded;
+
+    host_capsense_init();
+    capsense_fss_init();
+    capsense_fss_set_enable_mask(mask);
+
+    if (grouping->neighbours)
+    {
+        memset(neighbours, 0, sizeof(neighbours));
+        for (uint32_t key = 0u; key < HOST_BUTTON_SENSOR_COUNT; key++)
+        {
+            for (uint32_t other = 0u; other < HOST_BUTTON_SENSOR_COUNT; other++)
+            {
+                uint32_t distance = (key > other) ? (key - other) : (other - key);
+
+                if ((0u != distance) && (distance <= grouping->size))
+                {
+                    neighbours[key].word[other / FSS_WORD_BITS] |= (fss_word_t)1u << (other % FSS_WORD_BITS);
+                }
+            }
+        }
+        loaded = capsense_fss_set_neighbours(neighbours, HOST_BUTTON_SENSOR_COUNT);
+    }
+    else
+    {
+        for (uint32_t first = 0u; first < HOST_BUTTON_SENSOR_COUNT; first += size)
+        {
+            groups[count].firstSensor = (uint8_t)first;
+            groups[count].sensorCount = (uint8_t)(((first + size) <= HOST_BUTTON_SENSOR_COUNT) ?
+                                                  size : (HOST_BUTTON_SENSOR_COUNT - first));
+            count++;
+        }
+        loaded = capsense_fss_set_groups(groups, (uint8_t)count);
+    }
+    if (!loaded)
+    {
+        fprintf(stderr, "fss_search: FSS rejected the groups\n");
+        exit(EXIT_FAILURE);
+    }
+
+    host_capsense_set_buttons(untouched);
+    capsense_fss();
+}
+
+
+/*******************************************************************************
+* Function Name: search_run
+********************************************************************************
+* Summary:
+*  Runs a labelled trace through capsense_fss() and adds up the results. A
+*  button only counts as touched once it has been touched for debounce
+*  frames in a row, as the debounce of the CAPSENSE middleware does on a
+*  trace recorded with a debounce of 1. An intended press starts in the
+*  frame its label is set and is reported in the first frame FSS turns its
+*  button on, the latency being the frames in between; a press that ends
+*  before is missed. A button that FSS turns on while it is not intended is
+*  a wrong key. The touched buttons keep the difference counts of the trace.
+*
+*******************************************************************************/
+static void search_run(const fss_trace_t *trace, uint32_t debounce, search_stats_t *stats)
+{
+    uint8_t touch[HOST_BUTTON_SENSOR_COUNT];
+    uint32_t held[HOST_BUTTON_SENSOR_COUNT] = { 0 };
+    uint8_t out[HOST_BUTTON_SENSOR_COUNT];
+    uint8_t lastOut[HOST_BUTTON_SENSOR_COUNT] = { 0 };
+    uint8_t lastLabel[HOST_BUTTON_SENSOR_COUNT] = { 0 };
+    bool pending[HOST_BUTTON_SENSOR_COUNT] = { false };
+    uint32_t start[HOST_BUTTON_SENSOR_COUNT] = { 0 };
+
+    for (uint32_t frame = 0u; frame < trace->frames; frame++)
+    {
+        const uint8_t *raw = fss_trace_frame(trace, frame);
+        const uint8_t *label = fss_trace_label(trace, frame);
+
+        for (uint32_t button = 0u; button < HOST_BUTTON_SENSOR_COUNT; button++)
+        {
+            held[button] = (0u != raw[button]) ? (held[button] + ((held[button] < debounce) ? 1u : 0u)) : 0u;
+            touch[button] = (held[button] >= debounce) ? raw[button] : 0u;
+        }
+
+        host_capsense_set_buttons(touch);
+        capsense_fss();
+        host_capsense_get_buttons(out);
+
+        for (uint32_t button = 0u; button < HOST_BUTTON_SENSOR_COUNT; button++)
+        {
+            if ((0u != label[button]) && (0u == lastLabel[button]))
+            {
+                stats->presses++;
+                pending[button] = true;
+                start[button] = frame;
+            }
+            else if ((0u == label[button]) && pending[button])
+            {
+                stats->missed++;
+                pending[button] = false;
+            }
+
+            if ((0u != out[button]) && pending[button])
+            {
+                uint64_t latency = frame - start[button];
+
+                stats->reported++;
+                stats->latencySum += latency;
+                stats->latencyMax = (latency > stats->latencyMax) ? latency : stats->latencyMax;
+                pending[button] = false;
+            }
+            if ((0u != out[button]) && (0u == lastOut[button]) && (0u == label[button]))
+            {
+                stats->wrong++;
+            }
+
+            lastOut[button] = out[button];
+            lastLabel[button] = label[button];
+        }
+    }
+
+    for (uint32_t button = 0u; button < HOST_BUTTON_SENSOR_COUNT; button++)
+    {
+        stats->missed += pending[button] ? 1u : 0u;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: search_worker
+********************************************************************************
+* Summary:
+*  Evaluates every step-th configuration of the tie-break of the build from
+*  first on, over all the traces, and writes one result line per
+*  configuration to stdout:
+*      <index> <presses> <reported> <missed> <wrong> <latency sum> <latency max>
+*
+*******************************************************************************/
+static void search_worker(uint32_t tieBreak, uint32_t first, uint32_t step)
+{
+    for (uint32_t config = first; config < config_count; config += step)
+    {
+        uint32_t debounce = debounces[config % debounce_count];
+        const search_grouping_t *grouping = &groupings[(config / debounce_count) % grouping_count];
+        const fss_bitmap_t *mask = &masks[config / (debounce_count * grouping_count)];
+        search_stats_t stats;
+
+        memset(&stats, 0, sizeof(stats));
+        for (uint32_t trace = 0u; trace < trace_count; trace++)
+        {
+            search_setup(mask, grouping);
+            search_run(&traces[trace], debounce, &stats);
+        }
+
+        printf("%u %llu %llu %llu %llu %llu %llu\n", (tieBreak * config_count) + config,
+               (unsigned long long)stats.presses, (unsigned long long)stats.reported,
+               (unsigned long long)stats.missed, (unsigned long long)stats.wrong,
+               (unsigned long long)stats.latencySum, (unsigned long long)stats.latencyMax);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: search_latency
+********************************************************************************
+* Summary:
+*  Returns the average latency of a configuration, the worst possible when
+*  it reported no press.
+*
+*******************************************************************************/
+static double search_latency(const search_stats_t *stats)
+{
+    return (0u != stats->reported) ? ((double)stats->latencySum / (double)stats->reported) : (double)UINT32_MAX;
+}
+
+
+/*******************************************************************************
+* Function Name: search_rate
+********************************************************************************
+* Summary:
+*  Returns a count in percent of the intended presses.
+*
+*******************************************************************************/
+static double search_rate(uint64_t count, const search_stats_t *stats)
+{
+    return (0u != stats->presses) ? ((100.0 * (double)count) / (double)stats->presses) : 0.0;
+}
+
+
+/*******************************************************************************
+* Function Name: search_dominates
+********************************************************************************
+* Summary:
+*  Returns whether a configuration is at least as good as another on the
+*  latency, the wrong keys and the missed keys, and better on one of them.
+*
+*******************************************************************************/
+static bool search_dominates(const search_stats_t *a, const search_stats_t *b)
+{
+    double latencyA = search_latency(a);
+    double latencyB = search_latency(b);
+
+    return (latencyA <= latencyB) && (a->wrong <= b->wrong) && (a->missed <= b->missed) &&
+           ((latencyA < latencyB) || (a->wrong < b->wrong) || (a->missed < b->missed));
+}
+
+
+/* Results of all the configurations, for search_compare() */
+static const search_stats_t *search_results;
+
+/*******************************************************************************
+* Function Name: search_compare
+********************************************************************************
+* Summary:
+*  qsort() comparison of two configuration indices: the lower latency
+*  first, then the fewer wrong keys, then the fewer missed keys.
+*
+*******************************************************************************/
+static int search_compare(const void *a, const void *b)
+{
+    const search_stats_t *first = &search_results[*(const uint32_t *)a];
+    const search_stats_t *second = &search_results[*(const uint32_t *)b];
+    double latencyFirst = search_latency(first);
+    double latencySecond = search_latency(second);
+
+    if (latencyFirst != latencySecond)
+    {
+        return (latencyFirst < latencySecond) ? -1 : 1;
+    }
+    if (first->wrong != second->wrong)
+    {
+        return (first->wrong < second->wrong) ? -1 : 1;
+    }
+    return (first->missed > second->missed) - (first->missed < second->missed);
+}
+
+
+/*******************************************************************************
+* Function Name: search_print
+********************************************************************************
+* Summary:
+*  Prints the result row of a configuration.
+*
+*******************************************************************************/
+static void search_print(uint32_t index, const search_stats_t *stats, bool front)
+{
+    uint32_t config = index % config_count;
+    const search_grouping_t *grouping = &groupings[(config / debounce_count) % grouping_count];
+    char groupingText[24];
+
+    if (grouping->neighbours)
+    {
+        snprintf(groupingText, sizeof(groupingText), "neighbours %u", grouping->size);
+    }
+    else if (0u != grouping->size)
+    {
+        snprintf(groupingText, sizeof(groupingText), "groups of %u", grouping->size);
+    }
+    else
+    {
+        snprintf(groupingText, sizeof(groupingText), "one group");
+    }
+
+    printf("%c %-9s %8u  %-14s %-12.12s ", front ? '*' : ' ', tie_break_name[index / config_count],
+           debounces[config % debounce_count], groupingText,
+           mask_text[config / (debounce_count * grouping_count)]);
+    if (0u != stats->reported)
+    {
+        printf("%11.2f %11llu", search_latency(stats), (unsigned long long)stats->latencyMax);
+    }
+    else
+    {
+        printf("%11s %11s", "-", "-");
+    }
+    printf(" %7.2f%% %7.2f%%\n", search_rate(stats->wrong, stats), search_rate(stats->missed, stats));
+}
+
+
+/*******************************************************************************
+* Function Name: search_spawn
+********************************************************************************
+* Summary:
+*  Starts a worker running the build of a tie-break with the same arguments
+*  and returns the read end of its stdout, or -1 on error.
+*
+*******************************************************************************/
+static int search_spawn(const char *directory, char *argv[], int argc, uint32_t tieBreak,
+                        uint32_t first, uint32_t step)
+{
+    char path[SEARCH_PATH_LENGTH + SEARCH_NAME_LENGTH];
+    char work[48];
+    char **args;
+    int fd[2];
+    pid_t pid;
+
+    snprintf(path, sizeof(path), "%s/fss_search%s", directory, tie_break_suffix[tieBreak]);
+    snprintf(work, sizeof(work), "%u,%u,%u", tieBreak, first, step);
+
+    args = calloc((size_t)argc + 3u, sizeof(args[0]));
+    if ((NULL == args) || (0 != pipe(fd)))
+    {
+        perror("fss_search");
+        return -1;
+    }
+    args[0] = path;
+    args[1] = "-W";
+    args[2] = work;
+    for (int arg = 1; arg < argc; arg++)
+    {
+        args[arg + 2] = argv[arg];
+    }
+
+    fflush(stdout);
+    pid = fork();
+    if (0 == pid)
+    {
+        close(fd[0]);
+        dup2(fd[1], STDOUT_FILENO);
+        close(fd[1]);
+        execv(path, args);
+        perror(path);
+        _exit(EXIT_FAILURE);
+    }
+
+    free(args);
+    close(fd[1]);
+    if (pid < 0)
+    {
+        perror("fss_search");
+        close(fd[0]);
+        return -1;
+    }
+    return fd[0];
+}
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Usage: fss_search [-j workers] [-t tie-breaks] [-d debounces] [-g group
+*         sizes] [-a neighbour distances] [-m enable mask ...] [-f wrong %]
+*         [-v] trace ...
+*  Evaluates every combination of the candidate tie-breaks (lowest,arrival,
+*  diff by default), debounce counts (1,2,3), groupings (-g: groups of that many
+*  consecutive buttons, 0 for one group; -a: a row of keys with the given
+*  neighbour distance; one group and distance 1 by default) and enable
+*  masks (-m, repeated; all buttons by default) over the labelled traces.
+*  The tie-break is chosen at compile time, so the configurations of each
+*  run in workers of its own build, fss_search_<tie-break> next to this one
+*  (fss_search for lowest), -j in total (one per online CPU by default).
+*  Prints the Pareto front on latency, wrong keys and missed keys, every
+*  configuration with -v, and with -f, the lowest latency within that rate
+*  of wrong keys.
+*
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+    long workers = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t values[SEARCH_MAX_CHOICES];
+    uint32_t count;
+    uint32_t work[3];
+    bool worker = false;
+    bool verbose = false;
+    bool defaultGroupings = true;
+    double spec = -1.0;
+    char directory[SEARCH_PATH_LENGTH];
+    search_stats_t *results;
+    bool *received;
+    uint32_t *order;
+    uint32_t total;
+    uint32_t best = UINT32_MAX;
+    uint64_t start = now_ns();
+    uint64_t frames = 0u;
+    int pipes[SEARCH_MAX_WORKERS];
+    int pipeCount = 0;
+    int failed = 0;
+    int opt;
+
+    (void)search_tie_break("lowest,arrival,diff");
+    debounces[0] = 1u;
+    debounces[1] = 2u;
+    debounces[2] = 3u;
+    debounce_count = 3u;
+    groupings[0].neighbours = false;
+    groupings[0].size = 0u;
+    groupings[1].neighbours = true;
+    groupings[1].size = 1u;
+    grouping_count = 2u;
+
+    while (-1 != (opt = getopt(argc, argv, "W:j:t:d:g:a:m:f:v")))
+    {
+        switch (opt)
+        {
+            case 'W':
+                worker = (3 == sscanf(optarg, "%u,%u,%u", &work[0], &work[1], &work[2])) &&
+                         (work[0] == SEARCH_BUILD_TIE_BREAK) && (0u != work[2]);
+                failed |= worker ? 0 : 1;
+                break;
+            case 'j':
+                workers = strtol(optarg, NULL, 0);
+                break;
+            case 't':
+                failed |= search_tie_break(optarg) ? 0 : 1;
+                break;
+            case 'd':
+                debounce_count = search_list(optarg, debounces);
+                for (uint32_t choice = 0u; choice < debounce_count; choice++)
+                {
+                    failed |= (0u == debounces[choice]) ? 1 : 0;
+                }
+                failed |= (0u == debounce_count) ? 1 : 0;
+                break;
+            case 'g':
+            case 'a':
+                /* The first -g or -a replaces the default groupings */
+                if (defaultGroupings)
+                {
+                    grouping_count = 0u;
+                    defaultGroupings = false;
+                }
+                count = search_list(optarg, values);
+                failed |= ((0u == count) || ((grouping_count + count) > SEARCH_MAX_CHOICES)) ? 1 : 0;
+                for (uint32_t choice = 0u; (0 == failed) && (choice < count); choice++)
+                {
+                    groupings[grouping_count].neighbours = ('a' == opt);
+                    groupings[grouping_count].size = values[choice];
+                    failed |= (('a' == opt) && (0u == values[choice])) ? 1 : 0;
+                    grouping_count++;
+                }
+                break;
+            case 'm':
+                if ((mask_count < SEARCH_MAX_CHOICES) && search_mask(optarg, &masks[mask_count]))
+                {
+                    mask_text[mask_count++] = optarg;
+                }
+                else
+                {
+                    failed = 1;
+                }
+                break;
+            case 'f':
+                spec = strtod(optarg, NULL);
+                break;
+            case 'v':
+                verbose = true;
+                break;
+            default:
+                failed = 1;
+                break;
+        }
+    }
+    if ((0 != failed) || (workers < 1) || (optind == argc))
+    {
+        fprintf(stderr, "usage: %s [-j workers] [-t tie-breaks] [-d debounces] [-g group sizes]\n"
+                "       [-a neighbour distances] [-m enable mask ...] [-f wrong %%] [-v] trace ...\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (0u == mask_count)
+    {
+        for (uint32_t sensor = 0u; sensor < HOST_BUTTON_SENSOR_COUNT; sensor++)
+        {
+            masks[0].word[sensor / FSS_WORD_BITS] |= (fss_word_t)1u << (sensor % FSS_WORD_BITS);
+        }
+        mask_text[0] = "all";
+        mask_count = 1u;
+    }
+    config_count = mask_count * grouping_count * debounce_count;
+    total = tie_break_count * config_count;
+
+    if ((argc - optind) > (int)SEARCH_MAX_TRACES)
+    {
+        fprintf(stderr, "fss_search: at most %u traces\n", SEARCH_MAX_TRACES);
+        return EXIT_FAILURE;
+    }
+    for (int arg = optind; arg < argc; arg++)
+    {
+        if (0 != fss_trace_load(&traces[trace_count], HOST_BUTTON_SENSOR_COUNT, argv[arg]))
+        {
+            fprintf(stderr, "%s: cannot read trace\n", argv[arg]);
+            return EXIT_FAILURE;
+        }
+        if (NULL == traces[trace_count].label)
+        {
+            fprintf(stderr, "%s: trace not labelled\n", argv[arg]);
+            return EXIT_FAILURE;
+        }
+        frames += traces[trace_count].frames;
+        trace_count++;
+    }
+
+    if (worker)
+    {
+        search_worker(work[0], work[1], work[2]);
+        return (0 == fflush(stdout)) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    /* The builds of the other tie-breaks are next to this one */
+    count = (uint32_t)readlink("/proc/self/exe", directory, sizeof(directory) - 1u);
+    if ((count >= (sizeof(directory) - 1u)) || (NULL == strrchr(directory, '/')))
+    {
+        fprintf(stderr, "fss_search: cannot find its own build\n");
+        return EXIT_FAILURE;
+    }
+    directory[count] = '\0';
+    *strrchr(directory, '/') = '\0';
+
+    /* Every tie-break gets its share of the workers */
+    workers = (workers > (long)SEARCH_MAX_WORKERS) ? (long)SEARCH_MAX_WORKERS : workers;
+    workers = (workers / (long)tie_break_count > 0) ? (workers / (long)tie_break_count) : 1;
+    workers = (workers > (long)config_count) ? (long)config_count : workers;
+    for (uint32_t tieBreak = 0u; (0 == failed) && (tieBreak < tie_break_count); tieBreak++)
+    {
+        for (long first = 0; (0 == failed) && (first < workers); first++)
+        {
+            int fd = search_spawn(directory, argv, argc, tie_breaks[tieBreak], (uint32_t)first, (uint32_t)workers);
+
+            failed |= (fd < 0) ? 1 : 0;
+            if (fd >= 0)
+            {
+                pipes[pipeCount++] = fd;
+            }
+        }
+    }
+
+    results = calloc(SEARCH_TIE_BREAK_COUNT * (size_t)config_count, sizeof(results[0]));
+    received = calloc(SEARCH_TIE_BREAK_COUNT * (size_t)config_count, sizeof(received[0]));
+    order = calloc(total, sizeof(order[0]));
+    if ((NULL == results) || (NULL == received) || (NULL == order))
+    {
+        perror("fss_search");
+        return EXIT_FAILURE;
+    }
+
+    for (int pipeIndex = 0; pipeIndex < pipeCount; pipeIndex++)
+    {
+        FILE *file = fdopen(pipes[pipeIndex], "r");
+        unsigned long long value[6];
+        unsigned int index;
+
+        while ((NULL != file) &&
+               (7 == fscanf(file, "%u %llu %llu %llu %llu %llu %llu", &index, &value[0], &value[1],
+                            &value[2], &value[3], &value[4], &value[5])))
+        {
+            if (index < (SEARCH_TIE_BREAK_COUNT * config_count))
+            {
+                results[index].presses = value[0];
+                results[index].reported = value[1];
+                results[index].missed = value[2];
+                results[index].wrong = value[3];
+                results[index].latencySum = value[4];
+                results[index].latencyMax = value[5];
+                received[index] = true;
+            }
+        }
+        if (NULL != file)
+        {
+            fclose(file);
+        }
+    }
+    for (;;)
+    {
+        int status;
+
+        if (wait(&status) < 0)
+        {
+            break;
+        }
+        if (!WIFEXITED(status) || (EXIT_SUCCESS != WEXITSTATUS(status)))
+        {
+            failed = 1;
+        }
+    }
+
+    /* The configurations of the chosen tie-breaks, in order */
+    count = 0u;
+    for (uint32_t tieBreak = 0u; tieBreak < tie_break_count; tieBreak++)
+    {
+        for (uint32_t config = 0u; config < config_count; config++)
+        {
+            uint32_t index = (tie_breaks[tieBreak] * config_count) + config;
+
+            failed |= received[index] ? 0 : 1;
+            order[count++] = index;
+        }
+    }
+    if (0 != failed)
+    {
+        fprintf(stderr, "fss_search: a worker failed\n");
+        return EXIT_FAILURE;
+    }
+
+    search_results = results;
+    qsort(order, total, sizeof(order[0]), search_compare);
+
+    printf("panel: %u button sensors, %u labelled traces, %llu frames, %llu intended presses\n",
+           (unsigned)HOST_BUTTON_SENSOR_COUNT, trace_count, (unsigned long long)frames,
+           (unsigned long long)results[order[0]].presses);
+    printf("  %-9s %8s  %-14s %-12s %11s %11s %8s %8s\n", "tie-break", "debounce", "grouping", "mask",
+           "latency avg", "latency max", "wrong", "missed");
+
+    for (uint32_t rank = 0u; rank < total; rank++)
+    {
+        bool front = true;
+
+        for (uint32_t other = 0u; front && (other < total); other++)
+        {
+            front = !search_dominates(&results[order[other]], &results[order[rank]]);
+        }
+        if (front || verbose)
+        {
+            search_print(order[rank], &results[order[rank]], front);
+        }
+        if ((UINT32_MAX == best) && (0u != results[order[rank]].reported) &&
+            (search_rate(results[order[rank]].wrong, &results[order[rank]]) <= spec))
+        {
+            best = order[rank];
+        }
+    }
+
+    if (spec >= 0.0)
+    {
+        if (UINT32_MAX != best)
+        {
+            printf("\nlowest latency with at most %.2f%% wrong keys:\n", spec);
+            search_print(best, &results[best], false);
+        }
+        else
+        {
+            printf("\nno configuration has at most %.2f%% wrong keys\n", spec);
+        }
+    }
+
+    fprintf(stderr, "%u configurations, %llu frames each, in %.3f s on %d workers\n", total,
+            (unsigned long long)frames, (double)(now_ns() - start) / 1e9, pipeCount);
+
+    return EXIT_SUCCESS;
+}
+
+
+/* [] END OF FILE */
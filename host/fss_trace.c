@@ -0,0 +1,472 @@
+/******************************************************************************
+* File Name: fss_trace.c
+*
+* Description: Touch sequence (trace) handling for the host harness.
+*
+*              Recorded trace file format, one entry per line:
+*                  <frames> <bitmap> [<label> [<counts>]]
+*              <frames> is how many consecutive frames the entry lasts and
+*              <bitmap> is the raw (pre-FSS) button status in hex, bit N
+*              being the Nth button sensor in widget order. <label>, in a
+*              labelled trace, gives the buttons the user meant to touch in
+*              the same form; entries without one mean none. <counts> gives
+*              the difference counts of the touched buttons, lowest first,
+*              as comma-separated numbers from 1 to 255 above the touch
+*              threshold; without it, they are all 1. Empty lines and
+*              lines starting with '#' are ignored.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <ctype.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fss_trace.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TRACE_LINE_LENGTH          (1024u)
+#define TRACE_INITIAL_FRAMES       (1024u)
+#define TRACE_MAX_FINGERS          (3u)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const char * const scenario_name[FSS_TRACE_SCENARIO_COUNT] =
+{
+    "synthetic idle",
+    "synthetic tap",
+    "synthetic flanking",
+    "synthetic multi-touch",
+    "synthetic noise",
+};
+
+/*******************************************************************************
+* Function Name: trace_random
+********************************************************************************
+* Summary:
+*  xorshift32, so that synthetic sequences are identical on every host.
+*
+*******************************************************************************/
+static uint32_t trace_random(uint32_t *state)
+{
+    uint32_t x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+
+/*******************************************************************************
+* Function Name: trace_alloc
+********************************************************************************
+* Summary:
+*  Allocates a zeroed (untouched) trace.
+*
+*******************************************************************************/
+static void trace_alloc(fss_trace_t *trace, uint32_t sensors, uint32_t frames)
+{
+    trace->frames = frames;
+    trace->sensors = sensors;
+    trace->touch = calloc((size_t)frames * sensors, 1u);
+    trace->label = NULL;
+    if (NULL == trace->touch)
+    {
+        perror("fss_trace");
+        exit(EXIT_FAILURE);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: trace_hold
+********************************************************************************
+* Summary:
+*  Marks a sensor touched for a run of frames, clipped to the trace length.
+*
+*******************************************************************************/
+static void trace_hold(fss_trace_t *trace, uint32_t sensor, uint32_t first, uint32_t count)
+{
+    for (uint32_t frame = first; (frame < trace->frames) && (frame < (first + count)); frame++)
+    {
+        trace->touch[((uint64_t)frame * trace->sensors) + sensor] = 1u;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: trace_hex
+********************************************************************************
+* Summary:
+*  Parses the hex bitmap at *cursor into one byte per sensor and moves the
+*  cursor past it.
+*******************************************************************************/
+static void trace_hex(char **cursor, uint8_t *touch, uint32_t sensors)
+{
+    const char *digits = *cursor;
+    uint32_t length;
+
+    for (length = 0u; isxdigit((unsigned char)digits[length]); length++)
+    {
+    }
+
+    for (uint32_t sensor = 0u; sensor < sensors; sensor++)
+    {
+        uint32_t digit = sensor / 4u;
+        uint8_t touched = 0u;
+
+        if (digit < length)
+        {
+            char c = digits[length - 1u - digit];
+            uint32_t nibble = (uint32_t)(isdigit((unsigned char)c) ? (c - '0') :
+                                         (tolower((unsigned char)c) - 'a' + 10));
+            touched = (uint8_t)((nibble >> (sensor % 4u)) & 1u);
+        }
+        touch[sensor] = touched;
+    }
+
+    *cursor += length;
+}
+
+
+/*******************************************************************************
+* Function Name: trace_counts
+********************************************************************************
+* Summary:
+*  Parses the comma-separated difference counts at *cursor, from 1 to 255,
+*  into the bytes of the touched sensors, lowest first, and moves the cursor
+*  past them. The touched sensors without a count keep 1. Returns false if
+*  a count is out of range.
+*******************************************************************************/
+static bool trace_counts(char **cursor, uint8_t *touch, uint32_t sensors)
+{
+    uint32_t sensor = 0u;
+
+    while (0 != isdigit((unsigned char)**cursor))
+    {
+        unsigned long count = strtoul(*cursor, cursor, 10);
+
+        if ((0u == count) || (count > UINT8_MAX))
+        {
+            return false;
+        }
+        while ((sensor < sensors) && (0u == touch[sensor]))
+        {
+            sensor++;
+        }
+        if (sensor < sensors)
+        {
+            touch[sensor++] = (uint8_t)count;
+        }
+        *cursor += (',' == **cursor) ? 1 : 0;
+    }
+
+    return true;
+}
+
+
+/*******************************************************************************
+* Function Name: trace_grow
+********************************************************************************
+* Summary:
+*  Reallocates the touches or the labels of a trace for capacity frames.
+*******************************************************************************/
+static void trace_grow(uint8_t **frames, uint32_t capacity, uint32_t sensors)
+{
+    uint8_t *grown = realloc(*frames, (size_t)capacity * sensors);
+
+    if (NULL == grown)
+    {
+        perror("fss_trace");
+        exit(EXIT_FAILURE);
+    }
+    *frames = grown;
+}
+
+
+/*******************************************************************************
+* Function Name: fss_trace_synthesize
+********************************************************************************
+* Summary:
+*  Generates one of the synthetic touch sequences.
+*
+*******************************************************************************/
+void fss_trace_synthesize(fss_trace_t *trace, uint32_t sensors,
+                          fss_trace_scenario_t scenario, uint32_t frames, uint32_t seed)
+{
+    uint32_t state = (0u != seed) ? seed : 1u;
+    uint32_t frame = 0u;
+
+    trace_alloc(trace, sensors, frames);
+
+    switch (scenario)
+    {
+        case FSS_TRACE_TAP:
+            /* Press for 8 frames, release for 4, moving one sensor along */
+            for (uint32_t sensor = 0u; frame < frames; frame += 12u)
+            {
+                trace_hold(trace, sensor, frame, 8u);
+                sensor = (sensor + 1u) % sensors;
+            }
+            break;
+
+        case FSS_TRACE_FLANKING:
+            /* The neighbours light up 1-3 frames after the intended sensor and
+             * are released in arbitrary order around its release.
+             */
+            while (frame < frames)
+            {
+                uint32_t centre = trace_random(&state) % sensors;
+                uint32_t hold = 10u + (trace_random(&state) % 20u);
+
+                trace_hold(trace, centre, frame, hold);
+                if (centre > 0u)
+                {
+                    uint32_t lag = 1u + (trace_random(&state) % 3u);
+                    trace_hold(trace, centre - 1u, frame + lag, hold + (trace_random(&state) % 5u) - lag);
+                }
+                if ((centre + 1u) < sensors)
+                {
+                    uint32_t lag = 1u + (trace_random(&state) % 3u);
+                    trace_hold(trace, centre + 1u, frame + lag, hold + (trace_random(&state) % 5u) - lag);
+                }
+                frame += hold + 5u + (trace_random(&state) % 10u);
+            }
+            break;
+
+        case FSS_TRACE_MULTI:
+            /* 0-3 fingers anywhere, changing every 5-20 frames */
+            while (frame < frames)
+            {
+                uint32_t fingers = trace_random(&state) % (TRACE_MAX_FINGERS + 1u);
+                uint32_t hold = 5u + (trace_random(&state) % 16u);
+
+                for (uint32_t finger = 0u; finger < fingers; finger++)
+                {
+                    trace_hold(trace, trace_random(&state) % sensors, frame, hold);
+                }
+                frame += hold;
+            }
+            break;
+
+        case FSS_TRACE_NOISE:
+            /* Every sensor touched with a 1 in 4 chance, independently per frame */
+            for (uint64_t i = 0u; i < ((uint64_t)frames * sensors); i++)
+            {
+                trace->touch[i] = (uint8_t)(0u == (trace_random(&state) & 3u));
+            }
+            break;
+
+        case FSS_TRACE_IDLE:
+        default:
+            break;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: fss_trace_scenario_name
+********************************************************************************
+* Summary:
+*  Returns a printable name for a synthetic sequence.
+*
+*******************************************************************************/
+const char *fss_trace_scenario_name(fss_trace_scenario_t scenario)
+{
+    return (scenario < FSS_TRACE_SCENARIO_COUNT) ? scenario_name[scenario] : "?";
+}
+
+
+/*******************************************************************************
+* Function Name: fss_trace_load
+********************************************************************************
+* Summary:
+*  Reads a recorded trace file, with its labels and difference counts if it
+*  has any. Bits above the number of sensors of the panel are dropped.
+*  Returns 0 on success.
+*
+*******************************************************************************/
+int fss_trace_load(fss_trace_t *trace, uint32_t sensors, const char *path)
+{
+    char line[TRACE_LINE_LENGTH];
+    uint32_t capacity = TRACE_INITIAL_FRAMES;
+    FILE *file = fopen(path, "r");
+
+    if (NULL == file)
+    {
+        return -1;
+    }
+
+    trace_alloc(trace, sensors, capacity);
+    trace->frames = 0u;
+
+    while (NULL != fgets(line, sizeof(line), file))
+    {
+        char *cursor = line;
+        unsigned long repeat;
+
+        while (isspace((unsigned char)*cursor))
+        {
+            cursor++;
+        }
+        if (('\0' == *cursor) || ('#' == *cursor))
+        {
+            continue;
+        }
+
+        repeat = strtoul(cursor, &cursor, 0);
+        while (isspace((unsigned char)*cursor))
+        {
+            cursor++;
+        }
+        if ((0u == repeat) || (0 == isxdigit((unsigned char)*cursor)))
+        {
+            fclose(file);
+            fss_trace_free(trace);
+            return -1;
+        }
+
+        while ((trace->frames + repeat) > capacity)
+        {
+            capacity *= 2u;
+            trace_grow(&trace->touch, capacity, sensors);
+            if (NULL != trace->label)
+            {
+                trace_grow(&trace->label, capacity, sensors);
+            }
+        }
+
+        trace_hex(&cursor, &trace->touch[(uint64_t)trace->frames * sensors], sensors);
+        while ((' ' == *cursor) || ('\t' == *cursor))
+        {
+            cursor++;
+        }
+        if ((NULL == trace->label) && (0 != isxdigit((unsigned char)*cursor)))
+        {
+            /* The first label: the entries before it had none */
+            trace->label = calloc((size_t)capacity * sensors, 1u);
+            if (NULL == trace->label)
+            {
+                perror("fss_trace");
+                exit(EXIT_FAILURE);
+            }
+        }
+        if (NULL != trace->label)
+        {
+            uint8_t *label = &trace->label[(uint64_t)trace->frames * sensors];
+
+            if (0 != isxdigit((unsigned char)*cursor))
+            {
+                trace_hex(&cursor, label, sensors);
+            }
+            else
+            {
+                memset(label, 0, sensors);
+            }
+        }
+        while ((' ' == *cursor) || ('\t' == *cursor))
+        {
+            cursor++;
+        }
+        if (!trace_counts(&cursor, &trace->touch[(uint64_t)trace->frames * sensors], sensors))
+        {
+            fclose(file);
+            fss_trace_free(trace);
+            return -1;
+        }
+
+        for (unsigned long copy = 1u; copy < repeat; copy++)
+        {
+            memcpy(&trace->touch[((uint64_t)trace->frames + copy) * sensors],
+                   &trace->touch[(uint64_t)trace->frames * sensors], sensors);
+            if (NULL != trace->label)
+            {
+                memcpy(&trace->label[((uint64_t)trace->frames + copy) * sensors],
+                       &trace->label[(uint64_t)trace->frames * sensors], sensors);
+            }
+        }
+        trace->frames += (uint32_t)repeat;
+    }
+
+    fclose(file);
+    return 0;
+}
+
+
+/*******************************************************************************
+* Function Name: fss_trace_free
+********************************************************************************
+* Summary:
+*  Releases a trace.
+*
+*******************************************************************************/
+void fss_trace_free(fss_trace_t *trace)
+{
+    free(trace->touch);
+    free(trace->label);
+    trace->touch = NULL;
+    trace->label = NULL;
+    trace->frames = 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: fss_trace_checksum
+********************************************************************************
+* Summary:
+*  FNV-1a over the post-FSS status of one frame. Two builds that report the
+*  same checksum for a sequence made identical decisions on every frame.
+*
+*******************************************************************************/
+uint32_t fss_trace_checksum(uint32_t checksum, const uint8_t *touch, uint32_t sensors)
+{
+    for (uint32_t i = 0u; i < sensors; i++)
+    {
+        checksum = (checksum ^ touch[i]) * 16777619u;
+    }
+    return checksum;
+}
+
+
+/* [] END OF FILE */
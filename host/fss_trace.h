@@ -0,0 +1,121 @@
+/******************************************************************************
+* File Name: fss_trace.h
+*
+* Description: Touch sequence (trace) handling for the host harness:
+*              synthetic sequence generation, the recorded trace file
+*              reader and the output checksum.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef FSS_TRACE_H
+#define FSS_TRACE_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define FSS_TRACE_CHECKSUM_INIT    (0x811c9dc5u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Synthetic touch sequences */
+typedef enum
+{
+    FSS_TRACE_IDLE,          /* No touch at all */
+    FSS_TRACE_TAP,           /* One finger tapping every sensor in turn */
+    FSS_TRACE_FLANKING,      /* A press that spills onto its neighbours */
+    FSS_TRACE_MULTI,         /* Up to three fingers anywhere on the panel */
+    FSS_TRACE_NOISE,         /* Random status every frame, the worst case */
+    FSS_TRACE_SCENARIO_COUNT
+} fss_trace_scenario_t;
+
+/* A touch sequence: one byte per sensor per frame, non-zero when touched,
+ * and then the difference count above the touch threshold. A labelled trace
+ * also gives the sensors the user meant to touch, in the same layout.
+ */
+typedef struct
+{
+    uint32_t frames;
+    uint32_t sensors;
+    uint8_t *touch;
+    uint8_t *label;                 /* Intended sensors, NULL if not labelled */
+} fss_trace_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void fss_trace_synthesize(fss_trace_t *trace, uint32_t sensors,
+                          fss_trace_scenario_t scenario, uint32_t frames, uint32_t seed);
+const char *fss_trace_scenario_name(fss_trace_scenario_t scenario);
+int  fss_trace_load(fss_trace_t *trace, uint32_t sensors, const char *path);
+void fss_trace_free(fss_trace_t *trace);
+uint32_t fss_trace_checksum(uint32_t checksum, const uint8_t *touch, uint32_t sensors);
+
+/*******************************************************************************
+* Function Name: fss_trace_frame
+********************************************************************************
+* Summary:
+*  Returns the per-sensor touch status of one frame.
+*
+*******************************************************************************/
+static inline const uint8_t *fss_trace_frame(const fss_trace_t *trace, uint32_t frame)
+{
+    return &trace->touch[(uint64_t)frame * trace->sensors];
+}
+
+
+
+/*******************************************************************************
+* Function Name: fss_trace_label
+********************************************************************************
+* Summary:
+*  Returns the per-sensor intended touches of one frame of a labelled trace.
+*
+*******************************************************************************/
+static inline const uint8_t *fss_trace_label(const fss_trace_t *trace, uint32_t frame)
+{
+    return &trace->label[(uint64_t)frame * trace->sensors];
+}
+
+#endif /* FSS_TRACE_H */
+
+
+/* [] END OF FILE */
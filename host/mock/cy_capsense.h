@@ -0,0 +1,157 @@
+/******************************************************************************
+* File Name: cy_capsense.h
+*
+* Description: Host stand-in for the subset of the CAPSENSE middleware
+*              (cy_capsense.h) used by the FSS code. Type and field names
+*              follow the middleware so the application sources compile
+*              unmodified on Linux.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CY_CAPSENSE_H
+#define CY_CAPSENSE_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include "cy_pdl.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define CY_CAPSENSE_SNS_TOUCH_STATUS_MASK   (0x01u)
+
+#define CY_CAPSENSE_NOT_BUSY                (0x00u)
+#define CY_CAPSENSE_SW_STS_BUSY             (0x80u)
+
+#define CY_CAPSENSE_STATUS_SUCCESS          (0x00u)
+#define CY_CAPSENSE_STATUS_HW_BUSY          (0x40u)
+
+/*******************************************************************************
+* Enumerations
+*******************************************************************************/
+typedef enum
+{
+    CY_CAPSENSE_WD_BUTTON_E             = 0x01u,
+    CY_CAPSENSE_WD_LINEAR_SLIDER_E      = 0x02u,
+    CY_CAPSENSE_WD_RADIAL_SLIDER_E      = 0x03u,
+    CY_CAPSENSE_WD_MATRIX_BUTTON_E      = 0x04u,
+    CY_CAPSENSE_WD_TOUCHPAD_E           = 0x05u,
+    CY_CAPSENSE_WD_PROXIMITY_E          = 0x06u,
+} cy_en_capsense_widget_type_t;
+
+typedef enum
+{
+    CY_CAPSENSE_START_SAMPLE_E          = 0x01u,
+    CY_CAPSENSE_END_OF_SCAN_E           = 0x02u,
+} cy_en_capsense_callback_event_t;
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+typedef struct
+{
+    uint16_t raw;
+    uint16_t bsln;
+    uint16_t diff;
+    uint8_t  status;
+    uint8_t  negBslnRstCnt;
+    uint8_t  idacComp;
+    uint8_t  bslnExt;
+} cy_stc_capsense_sensor_context_t;
+
+typedef struct
+{
+    uint16_t fingerTh;
+    uint16_t proxTh;
+    uint8_t  status;
+} cy_stc_capsense_widget_context_t;
+
+typedef struct
+{
+    cy_stc_capsense_widget_context_t * ptrWdContext;
+    cy_stc_capsense_sensor_context_t * ptrSnsContext;
+    uint16_t numSns;
+    uint8_t  numCols;
+    uint8_t  numRows;
+    uint8_t  senseMethod;
+    uint8_t  wdType;
+} cy_stc_capsense_widget_config_t;
+
+typedef struct
+{
+    uint32_t status;
+    uint16_t scanCounter;
+} cy_stc_capsense_common_context_t;
+
+typedef struct
+{
+    cy_stc_capsense_common_context_t * ptrCommonContext;
+    const cy_stc_capsense_widget_config_t * ptrWdConfig;
+} cy_stc_capsense_context_t;
+
+typedef struct
+{
+    uint16_t widgetIndex;
+    uint16_t sensorIndex;
+} cy_stc_active_scan_sns_t;
+
+typedef uint32_t cy_capsense_status_t;
+typedef void (*cy_capsense_callback_t)(cy_stc_active_scan_sns_t * ptrActiveScan);
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_capsense_status_t Cy_CapSense_ScanAllWidgets(cy_stc_capsense_context_t * context);
+cy_capsense_status_t Cy_CapSense_ScanWidget(uint32_t widgetId, cy_stc_capsense_context_t * context);
+cy_capsense_status_t Cy_CapSense_ProcessAllWidgets(cy_stc_capsense_context_t * context);
+cy_capsense_status_t Cy_CapSense_ProcessWidget(uint32_t widgetId, cy_stc_capsense_context_t * context);
+uint32_t Cy_CapSense_IsBusy(const cy_stc_capsense_context_t * context);
+uint32_t Cy_CapSense_IsAnyWidgetActive(const cy_stc_capsense_context_t * context);
+uint32_t Cy_CapSense_IsWidgetActive(uint32_t widgetId, const cy_stc_capsense_context_t * context);
+cy_en_syspm_status_t Cy_CapSense_DeepSleepCallback(cy_stc_syspm_callback_params_t * callbackParams,
+                                                   cy_en_syspm_callback_mode_t mode);
+uint32_t Cy_CapSense_RunTuner(cy_stc_capsense_context_t * context);
+cy_capsense_status_t Cy_CapSense_RegisterCallback(cy_en_capsense_callback_event_t callbackType,
+                                                  cy_capsense_callback_t callbackFunction,
+                                                  cy_stc_capsense_context_t * context);
+
+#endif /* CY_CAPSENSE_H */
+
+
+/* [] END OF FILE */
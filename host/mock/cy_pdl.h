@@ -0,0 +1,157 @@
+/******************************************************************************
+* File Name: cy_pdl.h
+*
+* Description: Host stand-in for the subset of the peripheral driver library
+*              (cy_pdl.h) used by the application sources: CPU sleep and
+*              Deep Sleep, interrupt masking and registration, barriers,
+*              SysTick and the watchdog timer. The simulated CAPSENSE and
+*              watchdog interrupts are delivered from here, see
+*              host_capsense.c.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CY_PDL_H
+#define CY_PDL_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define CY_SYSPM_SUCCESS                    (0x00u)
+#define CY_SYSPM_FAIL                       (0x01u)
+
+#define SysTick                             (&host_systick)
+#define SysTick_CTRL_ENABLE_Msk             (0x01u)
+#define SysTick_CTRL_CLKSOURCE_Msk          (0x04u)
+#define SysTick_LOAD_RELOAD_Msk             (0x00FFFFFFu)
+
+#define __DMB()                             __sync_synchronize()
+
+#define NVIC_EnableIRQ(irq)                 ((void)(irq))
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef uint32_t cy_en_syspm_status_t;
+
+typedef enum
+{
+    srss_interrupt_wdt_IRQn             = 8,
+} IRQn_Type;
+
+typedef enum
+{
+    CY_SYSPM_SLEEP                      = 0u,
+    CY_SYSPM_DEEPSLEEP                  = 1u,
+} cy_en_syspm_callback_type_t;
+
+typedef enum
+{
+    CY_SYSPM_CHECK_READY                = 0x01u,
+    CY_SYSPM_CHECK_FAIL                 = 0x02u,
+    CY_SYSPM_BEFORE_TRANSITION          = 0x04u,
+    CY_SYSPM_AFTER_TRANSITION           = 0x08u,
+} cy_en_syspm_callback_mode_t;
+
+typedef struct
+{
+    void *base;
+    void *context;
+} cy_stc_syspm_callback_params_t;
+
+typedef cy_en_syspm_status_t (*Cy_SysPmCallback)(cy_stc_syspm_callback_params_t *callbackParams,
+                                                 cy_en_syspm_callback_mode_t mode);
+
+typedef struct cy_stc_syspm_callback
+{
+    Cy_SysPmCallback callback;
+    cy_en_syspm_callback_type_t type;
+    uint32_t skipMode;
+    cy_stc_syspm_callback_params_t *callbackParams;
+    struct cy_stc_syspm_callback *prevItm;
+    struct cy_stc_syspm_callback *nextItm;
+} cy_stc_syspm_callback_t;
+
+typedef void (*cy_israddress)(void);
+
+typedef struct
+{
+    IRQn_Type intrSrc;
+    uint32_t intrPriority;
+} cy_stc_sysint_t;
+
+typedef struct
+{
+    volatile uint32_t CTRL;
+    volatile uint32_t LOAD;
+    volatile uint32_t VAL;
+    volatile uint32_t CALIB;
+} SysTick_Type;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Advanced by the simulated scans of host_capsense.c */
+extern SysTick_Type host_systick;
+
+extern uint32_t SystemCoreClock;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_en_syspm_status_t Cy_SysPm_CpuEnterSleep(void);
+cy_en_syspm_status_t Cy_SysPm_CpuEnterDeepSleep(void);
+bool Cy_SysPm_RegisterCallback(cy_stc_syspm_callback_t *handler);
+uint32_t Cy_SysInt_Init(const cy_stc_sysint_t *config, cy_israddress userIsr);
+void Cy_WDT_Enable(void);
+void Cy_WDT_Disable(void);
+void Cy_WDT_SetMatch(uint32_t match);
+uint32_t Cy_WDT_GetCount(void);
+void Cy_WDT_ClearInterrupt(void);
+void Cy_WDT_MaskInterrupt(void);
+void Cy_WDT_UnmaskInterrupt(void);
+void __disable_irq(void);
+void __enable_irq(void);
+
+#endif /* CY_PDL_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,103 @@
+/******************************************************************************
+* File Name: cycfg_capsense.h
+*
+* Description: Host stand-in for the CAPSENSE Configurator generated
+*              configuration header. Declares the middleware context and
+*              the helpers used by the host harness to drive it.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CYCFG_CAPSENSE_H
+#define CYCFG_CAPSENSE_H
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include "cy_capsense.h"
+#include "cycfg_capsense_defines.h"
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Returns the touch status captured by the next frame scan, one byte per
+ * button sensor, or NULL for no touch.
+ */
+/* Like the generated one, the tuner structure holds the sensor contexts of
+ * all widgets, in widget order
+ */
+typedef struct
+{
+    cy_stc_capsense_common_context_t commonContext;
+    cy_stc_capsense_sensor_context_t sensorContext[CY_CAPSENSE_SENSOR_COUNT];
+} cy_stc_capsense_tuner_t;
+
+typedef const uint8_t * (*host_scan_source_t)(void);
+
+/* Event counts of the simulated scan hardware and CPU */
+typedef struct
+{
+    uint32_t scans;          /* Scans started */
+    uint32_t sleeps;         /* Calls to Cy_SysPm_CpuEnterSleep() */
+    uint32_t otherWakeups;   /* Sleeps ended by an interrupt other than CAPSENSE */
+    uint32_t busyStarts;     /* Scans started while one was running */
+    uint32_t rawRaces;       /* Widgets processed while being scanned */
+    uint32_t tunerRuns;      /* Cy_CapSense_RunTuner() calls */
+    uint32_t deepSleeps;     /* Deep Sleeps entered */
+    uint32_t busyDeepSleeps; /* Deep Sleeps entered while a scan runs */
+    uint32_t wakeScans;      /* Scans of the ganged widget, counted before
+                              * the frame they take is given */
+} host_capsense_stats_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern cy_stc_capsense_context_t cy_capsense_context;
+extern cy_stc_capsense_tuner_t cy_capsense_tuner;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void host_capsense_init(void);
+void host_capsense_init_panel(uint32_t buttonCount);
+void host_capsense_set_buttons(const uint8_t *touch);
+void host_capsense_get_buttons(uint8_t *touch);
+void host_capsense_set_scan_source(host_scan_source_t source, uint32_t otherWakeupPeriod);
+const host_capsense_stats_t *host_capsense_get_stats(void);
+
+#endif /* CYCFG_CAPSENSE_H */
+
+
+/* [] END OF FILE */
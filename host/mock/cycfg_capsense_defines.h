@@ -0,0 +1,95 @@
+/******************************************************************************
+* File Name: cycfg_capsense_defines.h
+*
+* Description: Host stand-in for the CAPSENSE Configurator generated
+*              defines. The sensor layout is selected at compile time with
+*              the HOST_* macros so that one source tree can be benchmarked
+*              against several panel sizes.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CYCFG_CAPSENSE_DEFINES_H
+#define CYCFG_CAPSENSE_DEFINES_H
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Number of button sensors in the simulated panel */
+#ifndef HOST_BUTTON_SENSOR_COUNT
+#define HOST_BUTTON_SENSOR_COUNT            (3u)
+#endif
+
+/* Number of sensors per button widget. The last widget holds the remainder. */
+#ifndef HOST_SENSORS_PER_BUTTON_WIDGET
+#define HOST_SENSORS_PER_BUTTON_WIDGET      (2u)
+#endif
+
+/* Number of non-button widgets (sliders, proximity) interleaved with the
+ * button widgets. They are skipped by FSS but still cost a widget walk.
+ */
+#ifndef HOST_OTHER_WIDGET_COUNT
+#define HOST_OTHER_WIDGET_COUNT             (2u)
+#endif
+
+/* Number of sensors in each non-button widget */
+#define HOST_SENSORS_PER_OTHER_WIDGET       (5u)
+
+/* Set to 1 to add, after all the others, a proximity widget with one sensor
+ * ganged with all the buttons: it is active while any button is touched
+ */
+#ifndef HOST_WAKE_WIDGET_ENABLE
+#define HOST_WAKE_WIDGET_ENABLE             (0u)
+#endif
+
+#define HOST_WAKE_WIDGET_COUNT              ((HOST_WAKE_WIDGET_ENABLE != 0u) ? 1u : 0u)
+
+#define HOST_BUTTON_WIDGET_COUNT            ((HOST_BUTTON_SENSOR_COUNT + \
+                                              HOST_SENSORS_PER_BUTTON_WIDGET - 1u) / \
+                                             HOST_SENSORS_PER_BUTTON_WIDGET)
+
+#define CY_CAPSENSE_WIDGET_COUNT            (HOST_BUTTON_WIDGET_COUNT + HOST_OTHER_WIDGET_COUNT + \
+                                             HOST_WAKE_WIDGET_COUNT)
+#define CY_CAPSENSE_SENSOR_COUNT            (HOST_BUTTON_SENSOR_COUNT + \
+                                             (HOST_OTHER_WIDGET_COUNT * HOST_SENSORS_PER_OTHER_WIDGET) + \
+                                             HOST_WAKE_WIDGET_COUNT)
+
+/* Index of the ganged widget, with HOST_WAKE_WIDGET_ENABLE */
+#define HOST_WAKE_WIDGET                    (CY_CAPSENSE_WIDGET_COUNT - 1u)
+
+#endif /* CYCFG_CAPSENSE_DEFINES_H */
+
+
+/* [] END OF FILE */
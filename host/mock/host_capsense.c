@@ -0,0 +1,820 @@
+/******************************************************************************
+* File Name: host_capsense.c
+*
+* Description: Host stand-in for the CAPSENSE Configurator generated
+*              context. Builds a widget layout that interleaves button
+*              widgets with non-button widgets and lets the harness set and
+*              read back the per-sensor touch status.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cycfg_capsense.h"
+#include "cy_pdl.h"
+#include "capsense_fss_algorithm.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Difference count of a touched sensor: this touch threshold plus its touch
+ * byte, which a trace gives as the count above the threshold
+ */
+#define HOST_TOUCH_DIFF                     (200u)
+
+/* host_scan_widget while Cy_CapSense_ScanAllWidgets() runs */
+#define HOST_SCAN_ALL                       (0xFFFFFFFFu)
+
+/* Room for the registered Deep Sleep callbacks */
+#define HOST_DEEP_SLEEP_CALLBACKS           (4u)
+
+/* SysTick ticks taken by the scan of one widget */
+#define HOST_WIDGET_SCAN_TICKS              (4800u)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static cy_stc_capsense_widget_context_t host_wd_context[CY_CAPSENSE_WIDGET_COUNT];
+static cy_stc_capsense_widget_config_t  host_wd_config[CY_CAPSENSE_WIDGET_COUNT];
+static cy_stc_capsense_common_context_t host_common_context;
+
+/* Sensor context of every button sensor in widget order */
+static cy_stc_capsense_sensor_context_t * host_button_sns[HOST_BUTTON_SENSOR_COUNT];
+
+/* Button sensors of the panel built by host_capsense_init_panel() */
+static uint32_t host_button_count;
+
+/* Button index of the first sensor of every button widget */
+static uint32_t host_wd_first_button[CY_CAPSENSE_WIDGET_COUNT];
+
+cy_stc_capsense_context_t cy_capsense_context =
+{
+    .ptrCommonContext = &host_common_context,
+    .ptrWdConfig = host_wd_config,
+};
+
+cy_stc_capsense_tuner_t cy_capsense_tuner;
+
+SysTick_Type host_systick;
+
+uint32_t SystemCoreClock = 48000000u;
+
+/* Simulated scan hardware and interrupt state */
+static host_scan_source_t host_scan_source;
+static const uint8_t *host_scan_touch;
+static uint32_t host_scan_widget;
+static cy_capsense_callback_t host_eos_callback;
+static cy_stc_active_scan_sns_t host_active_scan;
+static uint32_t host_other_wakeup_period;
+static uint32_t host_irq_masked;
+static uint32_t host_irq_pending;
+static host_capsense_stats_t host_stats;
+
+/* Simulated watchdog timer, Deep Sleep callbacks and watchdog interrupt */
+static uint32_t host_wdt_enabled;
+static uint32_t host_wdt_unmasked;
+static uint32_t host_wdt_match;
+static uint32_t host_wdt_count;
+static uint32_t host_wdt_pending;
+static cy_israddress host_wdt_isr;
+static cy_stc_syspm_callback_t *host_deep_sleep_callback[HOST_DEEP_SLEEP_CALLBACKS];
+static uint32_t host_deep_sleep_callback_count;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void host_capsense_start_scan(uint32_t widget);
+static void host_capsense_capture(uint32_t widget);
+static void host_capsense_isr(void);
+static void host_wdt_interrupt(void);
+
+/*******************************************************************************
+* Function Name: host_capsense_init
+********************************************************************************
+* Summary:
+*  Builds the widget layout of a panel of HOST_BUTTON_SENSOR_COUNT buttons.
+*
+*******************************************************************************/
+void host_capsense_init(void)
+{
+    host_capsense_init_panel(HOST_BUTTON_SENSOR_COUNT);
+}
+
+
+/*******************************************************************************
+* Function Name: host_capsense_init_panel
+********************************************************************************
+* Summary:
+*  Builds the widget layout of a panel of buttonCount buttons, at most
+*  HOST_BUTTON_SENSOR_COUNT: button widgets alternate with non-button widgets
+*  until the latter run out, so FSS has to skip them on every widget walk.
+*  The widgets left over on a smaller panel have no sensors. With
+*  HOST_WAKE_WIDGET_ENABLE, the last widget is the ganged one. All sensor
+*  statuses are cleared.
+*
+*******************************************************************************/
+void host_capsense_init_panel(uint32_t buttonCount)
+{
+    uint32_t buttonsLeft = buttonCount;
+    uint32_t othersLeft = HOST_OTHER_WIDGET_COUNT;
+    uint32_t snsIndex = 0u;
+    uint32_t buttonIndex = 0u;
+    uint32_t sensor;
+
+    host_common_context.status = CY_CAPSENSE_NOT_BUSY;
+    host_scan_touch = NULL;
+    host_irq_masked = 0u;
+    host_irq_pending = 0u;
+    memset(&host_stats, 0, sizeof(host_stats));
+    host_wdt_enabled = 0u;
+    host_wdt_unmasked = 0u;
+    host_wdt_pending = 0u;
+    host_deep_sleep_callback_count = 0u;
+    host_button_count = buttonCount;
+    memset(cy_capsense_tuner.sensorContext, 0, sizeof(cy_capsense_tuner.sensorContext));
+
+    for (uint32_t widget = 0u; widget < CY_CAPSENSE_WIDGET_COUNT; widget++)
+    {
+        cy_stc_capsense_widget_config_t *wd = &host_wd_config[widget];
+        uint8_t isButton = ((0u != buttonsLeft) && ((0u == othersLeft) || (0u == (widget & 1u))));
+
+        wd->ptrWdContext = &host_wd_context[widget];
+        wd->ptrSnsContext = &cy_capsense_tuner.sensorContext[snsIndex];
+
+        if ((0u != HOST_WAKE_WIDGET_ENABLE) && (HOST_WAKE_WIDGET == widget))
+        {
+            wd->wdType = CY_CAPSENSE_WD_PROXIMITY_E;
+            wd->numSns = 1u;
+        }
+        else if (0u != isButton)
+        {
+            wd->wdType = CY_CAPSENSE_WD_BUTTON_E;
+            wd->numSns = (buttonsLeft < HOST_SENSORS_PER_BUTTON_WIDGET) ?
+                         buttonsLeft : HOST_SENSORS_PER_BUTTON_WIDGET;
+            buttonsLeft -= wd->numSns;
+            host_wd_first_button[widget] = buttonIndex;
+
+            for (sensor = 0u; sensor < wd->numSns; sensor++)
+            {
+                host_button_sns[buttonIndex++] = &wd->ptrSnsContext[sensor];
+            }
+        }
+        else if (0u != othersLeft)
+        {
+            wd->wdType = (0u == (othersLeft & 1u)) ? CY_CAPSENSE_WD_LINEAR_SLIDER_E :
+                                                     CY_CAPSENSE_WD_PROXIMITY_E;
+            wd->numSns = HOST_SENSORS_PER_OTHER_WIDGET;
+            othersLeft--;
+        }
+        else
+        {
+            wd->wdType = CY_CAPSENSE_WD_PROXIMITY_E;
+            wd->numSns = 0u;
+        }
+
+        wd->numCols = (uint8_t)wd->numSns;
+        wd->numRows = 1u;
+        snsIndex += wd->numSns;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: host_capsense_set_buttons
+********************************************************************************
+* Summary:
+*  Stands in for Cy_CapSense_ProcessAllWidgets(): sets the touch status (and
+*  a difference count growing with the byte) of every button sensor from
+*  touch[], one byte per sensor in FSS bit order.
+*
+*******************************************************************************/
+void host_capsense_set_buttons(const uint8_t *touch)
+{
+    for (uint32_t i = 0u; i < host_button_count; i++)
+    {
+        host_button_sns[i]->status = (0u != touch[i]) ? CY_CAPSENSE_SNS_TOUCH_STATUS_MASK : 0u;
+        host_button_sns[i]->diff = (0u != touch[i]) ? (uint16_t)(HOST_TOUCH_DIFF + touch[i]) : 0u;
+    }
+    host_common_context.scanCounter++;
+}
+
+
+/*******************************************************************************
+* Function Name: host_capsense_get_buttons
+********************************************************************************
+* Summary:
+*  Reads back the touch status of every button sensor after FSS: the sensor
+*  status as left by FSS or, without FSS_STATUS_WRITE_BACK, the FSS result.
+*
+*******************************************************************************/
+void host_capsense_get_buttons(uint8_t *touch)
+{
+    for (uint32_t i = 0u; i < host_button_count; i++)
+    {
+#if (FSS_STATUS_WRITE_BACK != 0u)
+        touch[i] = (uint8_t)(host_button_sns[i]->status & CY_CAPSENSE_SNS_TOUCH_STATUS_MASK);
+#else
+        touch[i] = capsense_fss_is_active((uint8_t)i) ? 1u : 0u;
+#endif
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: host_capsense_set_scan_source
+********************************************************************************
+* Summary:
+*  Sets the function that gives the touch status captured by each scan. With
+*  a non-zero otherWakeupPeriod, every that many sleeps end on an interrupt
+*  other than the CAPSENSE one, as the EZI2C interrupt does on target.
+*
+*******************************************************************************/
+void host_capsense_set_scan_source(host_scan_source_t source, uint32_t otherWakeupPeriod)
+{
+    host_scan_source = source;
+    host_other_wakeup_period = otherWakeupPeriod;
+}
+
+
+/*******************************************************************************
+* Function Name: host_capsense_get_stats
+********************************************************************************
+* Summary:
+*  Returns the event counts since host_capsense_init().
+*
+*******************************************************************************/
+const host_capsense_stats_t *host_capsense_get_stats(void)
+{
+    return &host_stats;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CapSense_ScanAllWidgets
+********************************************************************************
+* Summary:
+*  Starts a simulated scan of all widgets, capturing the next frame of the
+*  scan source. It completes when the CPU next sleeps.
+*
+*******************************************************************************/
+cy_capsense_status_t Cy_CapSense_ScanAllWidgets(cy_stc_capsense_context_t * context)
+{
+    if (0u != (context->ptrCommonContext->status & CY_CAPSENSE_SW_STS_BUSY))
+    {
+        host_stats.busyStarts++;
+        return CY_CAPSENSE_STATUS_HW_BUSY;
+    }
+
+    host_capsense_start_scan(HOST_SCAN_ALL);
+    return CY_CAPSENSE_STATUS_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CapSense_ScanWidget
+********************************************************************************
+* Summary:
+*  Starts a simulated scan of one widget. The scan of widget 0 captures the
+*  next frame of the scan source; the other widgets are scanned from the
+*  same frame.
+*
+*******************************************************************************/
+cy_capsense_status_t Cy_CapSense_ScanWidget(uint32_t widgetId, cy_stc_capsense_context_t * context)
+{
+    if (0u != (context->ptrCommonContext->status & CY_CAPSENSE_SW_STS_BUSY))
+    {
+        host_stats.busyStarts++;
+        return CY_CAPSENSE_STATUS_HW_BUSY;
+    }
+
+    host_capsense_start_scan(widgetId);
+    return CY_CAPSENSE_STATUS_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CapSense_ProcessWidget
+********************************************************************************
+* Summary:
+*  Sets the status (and a matching difference count) of the button sensors
+*  of a widget, and of the ganged sensor, from their raw counts, which hold
+*  the touch status captured by the last scan of the widget. Processing a
+*  widget that is being scanned is counted as a raw count race.
+*
+*******************************************************************************/
+cy_capsense_status_t Cy_CapSense_ProcessWidget(uint32_t widgetId, cy_stc_capsense_context_t * context)
+{
+    const cy_stc_capsense_widget_config_t *wd = &context->ptrWdConfig[widgetId];
+
+    if ((0u != (context->ptrCommonContext->status & CY_CAPSENSE_SW_STS_BUSY)) &&
+        ((HOST_SCAN_ALL == host_scan_widget) || (widgetId == host_scan_widget)))
+    {
+        host_stats.rawRaces++;
+    }
+
+    if ((CY_CAPSENSE_WD_BUTTON_E == wd->wdType) ||
+        ((0u != HOST_WAKE_WIDGET_ENABLE) && (HOST_WAKE_WIDGET == widgetId)))
+    {
+        for (uint32_t sensor = 0u; sensor < wd->numSns; sensor++)
+        {
+            cy_stc_capsense_sensor_context_t *sns = &wd->ptrSnsContext[sensor];
+
+            sns->status = (0u != sns->raw) ? CY_CAPSENSE_SNS_TOUCH_STATUS_MASK : 0u;
+            sns->diff = (0u != sns->raw) ? (uint16_t)(HOST_TOUCH_DIFF + sns->raw) : 0u;
+        }
+    }
+
+    return CY_CAPSENSE_STATUS_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CapSense_ProcessAllWidgets
+********************************************************************************
+* Summary:
+*  Processes every widget with Cy_CapSense_ProcessWidget().
+*
+*******************************************************************************/
+cy_capsense_status_t Cy_CapSense_ProcessAllWidgets(cy_stc_capsense_context_t * context)
+{
+    for (uint32_t widget = 0u; widget < CY_CAPSENSE_WIDGET_COUNT; widget++)
+    {
+        (void)Cy_CapSense_ProcessWidget(widget, context);
+    }
+
+    return CY_CAPSENSE_STATUS_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CapSense_IsBusy
+********************************************************************************
+* Summary:
+*  Returns the busy flag set while a simulated scan runs.
+*
+*******************************************************************************/
+uint32_t Cy_CapSense_IsBusy(const cy_stc_capsense_context_t * context)
+{
+    return context->ptrCommonContext->status & CY_CAPSENSE_SW_STS_BUSY;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CapSense_IsAnyWidgetActive
+********************************************************************************
+* Summary:
+*  Returns non-zero if any sensor shows a touch.
+*
+*******************************************************************************/
+uint32_t Cy_CapSense_IsAnyWidgetActive(const cy_stc_capsense_context_t * context)
+{
+    for (uint32_t widget = 0u; widget < CY_CAPSENSE_WIDGET_COUNT; widget++)
+    {
+        if (0u != Cy_CapSense_IsWidgetActive(widget, context))
+        {
+            return 1u;
+        }
+    }
+
+    return 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CapSense_IsWidgetActive
+********************************************************************************
+* Summary:
+*  Returns non-zero if a sensor of the widget shows a touch.
+*
+*******************************************************************************/
+uint32_t Cy_CapSense_IsWidgetActive(uint32_t widgetId, const cy_stc_capsense_context_t * context)
+{
+    const cy_stc_capsense_widget_config_t *wd = &context->ptrWdConfig[widgetId];
+
+    for (uint32_t sensor = 0u; sensor < wd->numSns; sensor++)
+    {
+        if (0u != (wd->ptrSnsContext[sensor].status & CY_CAPSENSE_SNS_TOUCH_STATUS_MASK))
+        {
+            return 1u;
+        }
+    }
+
+    return 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CapSense_DeepSleepCallback
+********************************************************************************
+* Summary:
+*  Refuses Deep Sleep while a scan runs.
+*
+*******************************************************************************/
+cy_en_syspm_status_t Cy_CapSense_DeepSleepCallback(cy_stc_syspm_callback_params_t * callbackParams,
+                                                   cy_en_syspm_callback_mode_t mode)
+{
+    const cy_stc_capsense_context_t *context = (const cy_stc_capsense_context_t *)callbackParams->context;
+
+    if ((CY_SYSPM_CHECK_READY == mode) && (0u != Cy_CapSense_IsBusy(context)))
+    {
+        return CY_SYSPM_FAIL;
+    }
+
+    return CY_SYSPM_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CapSense_RunTuner
+********************************************************************************
+* Summary:
+*  There is no tuner host on Linux; only counts the call.
+*
+*******************************************************************************/
+uint32_t Cy_CapSense_RunTuner(cy_stc_capsense_context_t * context)
+{
+    (void)context;
+    host_stats.tunerRuns++;
+
+    return 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CapSense_RegisterCallback
+********************************************************************************
+* Summary:
+*  Records the end-of-scan callback.
+*
+*******************************************************************************/
+cy_capsense_status_t Cy_CapSense_RegisterCallback(cy_en_capsense_callback_event_t callbackType,
+                                                  cy_capsense_callback_t callbackFunction,
+                                                  cy_stc_capsense_context_t * context)
+{
+    (void)context;
+
+    if (CY_CAPSENSE_END_OF_SCAN_E == callbackType)
+    {
+        host_eos_callback = callbackFunction;
+    }
+
+    return CY_CAPSENSE_STATUS_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_SysPm_CpuEnterSleep
+********************************************************************************
+* Summary:
+*  Stands in for WFI: the running scan completes and raises its interrupt,
+*  unless another interrupt wakes the CPU first. The interrupt is taken at
+*  once, or by __enable_irq() if interrupts are masked. Sleeping with no scan
+*  running would hang the target, so it ends the program.
+*
+*******************************************************************************/
+cy_en_syspm_status_t Cy_SysPm_CpuEnterSleep(void)
+{
+    host_stats.sleeps++;
+
+    if ((0u != host_other_wakeup_period) && (0u == (host_stats.sleeps % host_other_wakeup_period)))
+    {
+        host_stats.otherWakeups++;
+    }
+    else if (0u != (host_common_context.status & CY_CAPSENSE_SW_STS_BUSY))
+    {
+        host_irq_pending = 1u;
+        if (0u == host_irq_masked)
+        {
+            host_capsense_isr();
+        }
+    }
+    else
+    {
+        /* Nothing would ever wake the CPU */
+        fprintf(stderr, "sleep with no scan running\n");
+        exit(EXIT_FAILURE);
+    }
+
+    return CY_SYSPM_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_SysPm_CpuEnterDeepSleep
+********************************************************************************
+* Summary:
+*  Asks the registered callbacks, then stands in for Deep Sleep: the
+*  watchdog counts up to its match and raises its interrupt, which is taken
+*  at once, or by __enable_irq() if interrupts are masked. The CSD block does
+*  not run in Deep Sleep, so a scan running at this point is counted as an
+*  error. Deep Sleep without the watchdog interrupt would hang the target,
+*  so it ends the program.
+*
+*******************************************************************************/
+cy_en_syspm_status_t Cy_SysPm_CpuEnterDeepSleep(void)
+{
+    for (uint32_t callback = 0u; callback < host_deep_sleep_callback_count; callback++)
+    {
+        if (CY_SYSPM_SUCCESS != host_deep_sleep_callback[callback]->callback(
+                                    host_deep_sleep_callback[callback]->callbackParams, CY_SYSPM_CHECK_READY))
+        {
+            return CY_SYSPM_FAIL;
+        }
+    }
+
+    host_stats.deepSleeps++;
+    if (0u != (host_common_context.status & CY_CAPSENSE_SW_STS_BUSY))
+    {
+        host_stats.busyDeepSleeps++;
+    }
+
+    if ((0u == host_wdt_enabled) || (0u == host_wdt_unmasked) || (NULL == host_wdt_isr))
+    {
+        /* Nothing would ever wake the CPU */
+        fprintf(stderr, "deep sleep with no wakeup source\n");
+        exit(EXIT_FAILURE);
+    }
+
+    host_wdt_count = host_wdt_match;
+    host_wdt_pending = 1u;
+    if (0u == host_irq_masked)
+    {
+        host_wdt_interrupt();
+    }
+
+    return CY_SYSPM_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_SysPm_RegisterCallback
+********************************************************************************
+* Summary:
+*  Registers a Deep Sleep callback.
+*
+*******************************************************************************/
+bool Cy_SysPm_RegisterCallback(cy_stc_syspm_callback_t *handler)
+{
+    if ((CY_SYSPM_DEEPSLEEP != handler->type) || (host_deep_sleep_callback_count >= HOST_DEEP_SLEEP_CALLBACKS))
+    {
+        return false;
+    }
+
+    host_deep_sleep_callback[host_deep_sleep_callback_count++] = handler;
+    return true;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_SysInt_Init
+********************************************************************************
+* Summary:
+*  Registers the watchdog interrupt handler.
+*
+*******************************************************************************/
+uint32_t Cy_SysInt_Init(const cy_stc_sysint_t *config, cy_israddress userIsr)
+{
+    if (srss_interrupt_wdt_IRQn == config->intrSrc)
+    {
+        host_wdt_isr = userIsr;
+    }
+
+    return 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_WDT_xxx
+********************************************************************************
+* Summary:
+*  Simulated watchdog timer: a 16-bit counter with a match interrupt.
+*
+*******************************************************************************/
+void Cy_WDT_Enable(void)
+{
+    host_wdt_enabled = 1u;
+}
+
+void Cy_WDT_Disable(void)
+{
+    host_wdt_enabled = 0u;
+}
+
+void Cy_WDT_SetMatch(uint32_t match)
+{
+    host_wdt_match = match & 0xFFFFu;
+}
+
+uint32_t Cy_WDT_GetCount(void)
+{
+    return host_wdt_count;
+}
+
+void Cy_WDT_ClearInterrupt(void)
+{
+    host_wdt_pending = 0u;
+}
+
+void Cy_WDT_MaskInterrupt(void)
+{
+    host_wdt_unmasked = 0u;
+}
+
+void Cy_WDT_UnmaskInterrupt(void)
+{
+    host_wdt_unmasked = 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: __disable_irq
+********************************************************************************
+* Summary:
+*  Masks the simulated interrupts.
+*
+*******************************************************************************/
+void __disable_irq(void)
+{
+    host_irq_masked = 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: __enable_irq
+********************************************************************************
+* Summary:
+*  Unmasks the simulated interrupts and takes those that are pending.
+*
+*******************************************************************************/
+void __enable_irq(void)
+{
+    host_irq_masked = 0u;
+    if (0u != host_irq_pending)
+    {
+        host_capsense_isr();
+    }
+    if (0u != host_wdt_pending)
+    {
+        host_wdt_interrupt();
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: host_capsense_start_scan
+********************************************************************************
+* Summary:
+*  Marks the scan of a widget, or of all widgets, as running. A scan that
+*  starts a frame, or a wake-up scan of the ganged widget, takes the next
+*  frame from the scan source.
+*
+*******************************************************************************/
+static void host_capsense_start_scan(uint32_t widget)
+{
+    bool wakeScan = (0u != HOST_WAKE_WIDGET_ENABLE) && ((HOST_SCAN_ALL == widget) || (HOST_WAKE_WIDGET == widget));
+
+    if (wakeScan)
+    {
+        host_stats.wakeScans++;
+    }
+
+    if ((HOST_SCAN_ALL == widget) || (0u == widget) || wakeScan)
+    {
+        host_scan_touch = (NULL != host_scan_source) ? host_scan_source() : NULL;
+        host_common_context.scanCounter++;
+    }
+
+    host_scan_widget = widget;
+    host_common_context.status |= CY_CAPSENSE_SW_STS_BUSY;
+    host_stats.scans++;
+}
+
+
+/*******************************************************************************
+* Function Name: host_capsense_capture
+********************************************************************************
+* Summary:
+*  Writes the raw counts of a scanned widget: the touch status of the frame
+*  for button sensors, whether any button is touched for the ganged sensor,
+*  zero for the others.
+*
+*******************************************************************************/
+static void host_capsense_capture(uint32_t widget)
+{
+    const cy_stc_capsense_widget_config_t *wd = &host_wd_config[widget];
+
+    if ((0u != HOST_WAKE_WIDGET_ENABLE) && (HOST_WAKE_WIDGET == widget))
+    {
+        uint8_t touched = 0u;
+
+        for (uint32_t button = 0u; (button < host_button_count) && (NULL != host_scan_touch); button++)
+        {
+            touched |= (0u != host_scan_touch[button]) ? 1u : 0u;
+        }
+        wd->ptrSnsContext[0].raw = touched;
+        return;
+    }
+
+    for (uint32_t sensor = 0u; sensor < wd->numSns; sensor++)
+    {
+        wd->ptrSnsContext[sensor].raw = ((CY_CAPSENSE_WD_BUTTON_E == wd->wdType) && (NULL != host_scan_touch)) ?
+                                        host_scan_touch[host_wd_first_button[widget] + sensor] : 0u;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: host_capsense_isr
+********************************************************************************
+* Summary:
+*  Stands in for Cy_CapSense_InterruptHandler() at the end of the last
+*  sensor: writes the raw counts of the scanned widgets, clears the busy
+*  flag and calls the end-of-scan callback.
+*
+*******************************************************************************/
+static void host_capsense_isr(void)
+{
+    uint32_t widgets = 1u;
+
+    host_irq_pending = 0u;
+
+    if (HOST_SCAN_ALL == host_scan_widget)
+    {
+        for (uint32_t widget = 0u; widget < CY_CAPSENSE_WIDGET_COUNT; widget++)
+        {
+            host_capsense_capture(widget);
+        }
+        widgets = CY_CAPSENSE_WIDGET_COUNT;
+    }
+    else
+    {
+        host_capsense_capture(host_scan_widget);
+    }
+    host_systick.VAL = (host_systick.VAL - (widgets * HOST_WIDGET_SCAN_TICKS)) & SysTick_LOAD_RELOAD_Msk;
+    host_common_context.status &= ~(uint32_t)CY_CAPSENSE_SW_STS_BUSY;
+
+    if (NULL != host_eos_callback)
+    {
+        host_eos_callback(&host_active_scan);
+    }
+}
+
+
+
+/*******************************************************************************
+* Function Name: host_wdt_interrupt
+********************************************************************************
+* Summary:
+*  Calls the registered watchdog interrupt handler, which must clear the
+*  interrupt.
+*
+*******************************************************************************/
+static void host_wdt_interrupt(void)
+{
+    host_wdt_isr();
+    if (0u != host_wdt_pending)
+    {
+        fprintf(stderr, "watchdog interrupt not cleared\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,176 @@
+/******************************************************************************
+* File Name: table_check.c
+*
+* Description: Builds FSS with the tables that scripts/fss_tables.py
+*              generates from the host fixture design (design/), and checks
+*              that the generated button sensor table reaches the same
+*              sensor contexts as the widget walk of capsense_fss_init(),
+*              which the mock CAPSENSE context uses to set and read the
+*              button statuses.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+ * Include header files
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "cycfg_capsense.h"
+#include "capsense_fss_algorithm.h"
+
+#ifndef FSS_BUTTON_SENSOR_TABLE
+#error "table_check needs the generated tables: build it with FSS_GENERATED_TABLES"
+#endif
+
+#if (FSS_SENSOR_COUNT != HOST_BUTTON_SENSOR_COUNT)
+#error "The host fixture design does not match the mock panel size"
+#endif
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const fss_group_t check_groups[] = { FSS_GROUP_TABLE };
+static uint32_t check_failures;
+
+/*******************************************************************************
+* Function Name: check_frame
+********************************************************************************
+* Summary:
+*  Sets the touch of every button through the mock, runs FSS, and checks the
+*  raw status it gathered through the generated table, and the statuses it
+*  wrote back, against the touched buttons and the expected winners.
+*
+*******************************************************************************/
+static void check_frame(const char *name, const uint8_t *touch, const uint8_t *winners)
+{
+    uint8_t result[HOST_BUTTON_SENSOR_COUNT];
+    const fss_bitmap_t *raw;
+
+    host_capsense_set_buttons(touch);
+    capsense_fss();
+    raw = capsense_fss_get_raw_status();
+    host_capsense_get_buttons(result);
+
+    for (uint32_t i = 0u; i < HOST_BUTTON_SENSOR_COUNT; i++)
+    {
+        uint8_t gathered = (uint8_t)((raw->word[i / FSS_WORD_BITS] >> (i % FSS_WORD_BITS)) & 1u);
+
+        if (gathered != (uint8_t)(0u != touch[i]))
+        {
+            printf("FAIL %s: button %u reads %u through the generated table\n",
+                   name, (unsigned)i, (unsigned)gathered);
+            check_failures++;
+        }
+        if ((0u != result[i]) != (0u != winners[i]))
+        {
+            printf("FAIL %s: button %u is %s after FSS\n",
+                   name, (unsigned)i, (0u != result[i]) ? "on" : "off");
+            check_failures++;
+        }
+    }
+
+    /* The sensors of the other widgets are never touched */
+    for (uint32_t widget = 0u; widget < CY_CAPSENSE_WIDGET_COUNT; widget++)
+    {
+        const cy_stc_capsense_widget_config_t *wd = &cy_capsense_context.ptrWdConfig[widget];
+
+        for (uint32_t sensor = 0u; (wd->wdType != CY_CAPSENSE_WD_BUTTON_E) && (sensor < wd->numSns); sensor++)
+        {
+            if (0u != wd->ptrSnsContext[sensor].status)
+            {
+                printf("FAIL %s: sensor %u of widget %u, not a button, was written\n",
+                       name, (unsigned)sensor, (unsigned)widget);
+                check_failures++;
+            }
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Touches every button alone, then all of them, in which case only the first
+*  button of every generated group stays on.
+*
+*******************************************************************************/
+int main(void)
+{
+    uint8_t touch[HOST_BUTTON_SENSOR_COUNT];
+    uint8_t winners[HOST_BUTTON_SENSOR_COUNT];
+    char name[32];
+
+    host_capsense_init();
+    capsense_fss_init();
+
+    if (capsense_fss_get_sensor_count() != HOST_BUTTON_SENSOR_COUNT)
+    {
+        printf("FAIL: %u button sensors in the generated table, %u in the widgets\n",
+               (unsigned)capsense_fss_get_sensor_count(), (unsigned)HOST_BUTTON_SENSOR_COUNT);
+        check_failures++;
+    }
+
+    for (uint32_t i = 0u; i < HOST_BUTTON_SENSOR_COUNT; i++)
+    {
+        memset(touch, 0, sizeof(touch));
+        touch[i] = 1u;
+        (void)snprintf(name, sizeof(name), "button %u", (unsigned)i);
+        check_frame(name, touch, touch);
+    }
+
+    /* Released first, so that no button is held into the next frame */
+    memset(touch, 0, sizeof(touch));
+    check_frame("release", touch, touch);
+
+    memset(touch, 1, sizeof(touch));
+    memset(winners, 0, sizeof(winners));
+    for (uint32_t group = 0u; group < (sizeof(check_groups) / sizeof(check_groups[0])); group++)
+    {
+        winners[check_groups[group].firstSensor] = 1u;
+    }
+    check_frame("all buttons", touch, winners);
+
+    printf("Generated tables, %u buttons in %u groups: %s\n",
+           (unsigned)HOST_BUTTON_SENSOR_COUNT,
+           (unsigned)(sizeof(check_groups) / sizeof(check_groups[0])),
+           (0u == check_failures) ? "PASS" : "FAIL");
+
+    return (0u == check_failures) ? 0 : 1;
+}
+
+
+/* [] END OF FILE */
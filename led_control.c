@@ -43,49 +43,159 @@
 /*******************************************************************************
  * Include header files
  ******************************************************************************/
+#include <stdbool.h>
 #include "led_control.h"
+#include "capsense_fss_algorithm.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#ifndef FSS_LED_MAP_TABLE
+/* Bit of each button sensor in the FSS button status, where the button
+ * sensors are numbered in widget order. Refer README.md.
+ */
+#define BUTTON0_SNS0_BIT               (0u)
+#define BUTTON0_SNS1_BIT               (1u)
+#define BUTTON1_SNS0_BIT               (2u)
+#endif
+
+#define LED_PIN_MASK                   (0x00000001u)
+#define LED_COUNT                      (sizeof(ledMap) / sizeof(ledMap[0]))
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* An LED and the button sensor it indicates */
+typedef struct
+{
+    uint8_t sensor;                 /* Bit of the button in the FSS button status */
+    GPIO_PRT_Type *port;            /* GPIO port of the LED */
+    uint8_t pin;                    /* Pin of the LED in its port */
+} led_map_t;
+
+/* A GPIO port with LEDs */
+typedef struct
+{
+    GPIO_PRT_Type *port;
+    uint32_t pins;                  /* All LED pins of the port */
+} led_port_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Sensor-to-LED mapping. Generated from the design with the FSS tables,
+ * else add a line per LED.
+ */
+static const led_map_t ledMap[] =
+{
+#ifdef FSS_LED_MAP_TABLE
+    FSS_LED_MAP_TABLE
+#else
+    { BUTTON0_SNS0_BIT, CYBSP_LED_BTN2_PORT, CYBSP_LED_BTN2_NUM },
+    { BUTTON0_SNS1_BIT, CYBSP_LED_BTN1_PORT, CYBSP_LED_BTN1_NUM },
+    { BUTTON1_SNS0_BIT, CYBSP_LED_BTN0_PORT, CYBSP_LED_BTN0_NUM },
+#endif
+};
+
+/* Distinct ports of ledMap[], and the index in ledPort[] of every LED */
+#ifdef FSS_LED_PORT_TABLE
+static const led_port_t ledPort[] = { FSS_LED_PORT_TABLE };
+static const uint8_t ledPortOf[LED_COUNT] = { FSS_LED_PORT_INDEX_TABLE };
+static const uint8_t ledPortCount = (uint8_t)(sizeof(ledPort) / sizeof(ledPort[0]));
+#else
+static led_port_t ledPort[LED_COUNT];
+static uint8_t ledPortOf[LED_COUNT];
+static uint8_t ledPortCount = 0;
+#endif
+
+/* Button status shown by the LEDs */
+static fss_bitmap_t ledStatus;
+static bool ledStatusValid = false;
+
+/*******************************************************************************
+* Function Name: led_control_init
+********************************************************************************
+* Summary:
+*  This function groups the LEDs of ledMap[] by GPIO port, so that
+*  led_control() updates each port with one set and one clear write. The
+*  generated tables are already grouped.
+*
+*******************************************************************************/
+void led_control_init(void)
+{
+#ifndef FSS_LED_PORT_TABLE
+    uint8_t port;
+
+    ledPortCount = 0;
+
+    for (uint8_t led = 0; led < LED_COUNT; led++)
+    {
+        port = 0;
+        while ((port < ledPortCount) && (ledPort[port].port != ledMap[led].port))
+        {
+            port++;
+        }
+
+        if (port == ledPortCount)
+        {
+            ledPort[port].port = ledMap[led].port;
+            ledPort[port].pins = 0;
+            ledPortCount++;
+        }
+
+        ledPort[port].pins |= LED_PIN_MASK << ledMap[led].pin;
+        ledPortOf[led] = port;
+    }
+#endif
+
+    ledStatusValid = false;
+}
+
 
 /*******************************************************************************
 * Function Name: led_control
 ********************************************************************************
 * Summary:
 *  This function controls the LEDs to visually indicate the status of the
-*  corresponding buttons.
+*  corresponding buttons. The GPIO ports are only written when the button
+*  status has changed since the last call.
 *
 *******************************************************************************/
 void led_control(void)
 {
-    if(0 != Cy_CapSense_IsSensorActive(CY_CAPSENSE_BUTTON0_WDGT_ID, 
-                                       CY_CAPSENSE_BUTTON0_SNS0_ID, 
-                                       &cy_capsense_context))
-    {
-        Cy_GPIO_Write(CYBSP_LED_BTN2_PORT, CYBSP_LED_BTN2_NUM, CYBSP_LED_STATE_ON);
-    }
-    else
-    {
-        Cy_GPIO_Write(CYBSP_LED_BTN2_PORT, CYBSP_LED_BTN2_NUM, CYBSP_LED_STATE_OFF);
-    }
+    const fss_bitmap_t *status = capsense_fss_get_status();
+    uint32_t onPins[LED_COUNT] = { 0 };
+    bool changed = !ledStatusValid;
+    uint8_t word;
+    uint8_t port;
 
-    if(0 != Cy_CapSense_IsSensorActive(CY_CAPSENSE_BUTTON0_WDGT_ID, 
-                                       CY_CAPSENSE_BUTTON0_SNS1_ID, 
-                                       &cy_capsense_context))
+    for (word = 0; word < FSS_WORD_COUNT; word++)
     {
-        Cy_GPIO_Write(CYBSP_LED_BTN1_PORT, CYBSP_LED_BTN1_NUM, CYBSP_LED_STATE_ON);
+        changed |= (status->word[word] != ledStatus.word[word]);
     }
-    else
+
+    if (!changed)
     {
-        Cy_GPIO_Write(CYBSP_LED_BTN1_PORT, CYBSP_LED_BTN1_NUM, CYBSP_LED_STATE_OFF);
+        return;
     }
+    ledStatus = *status;
+    ledStatusValid = true;
 
-    if(0 != Cy_CapSense_IsSensorActive(CY_CAPSENSE_BUTTON1_WDGT_ID, 
-                                       CY_CAPSENSE_BUTTON0_SNS0_ID, 
-                                       &cy_capsense_context))
+    for (uint8_t led = 0; led < LED_COUNT; led++)
     {
-        Cy_GPIO_Write(CYBSP_LED_BTN0_PORT, CYBSP_LED_BTN0_NUM, CYBSP_LED_STATE_ON);
+        if (0u != (ledStatus.word[ledMap[led].sensor / FSS_WORD_BITS] &
+                   (LED_PIN_MASK << (ledMap[led].sensor % FSS_WORD_BITS))))
+        {
+            onPins[ledPortOf[led]] |= LED_PIN_MASK << ledMap[led].pin;
+        }
     }
-    else
+
+    for (port = 0; port < ledPortCount; port++)
     {
-        Cy_GPIO_Write(CYBSP_LED_BTN0_PORT, CYBSP_LED_BTN0_NUM, CYBSP_LED_STATE_OFF);
+        uint32_t highPins = (CYBSP_LED_STATE_ON != 0u) ? onPins[port] : (ledPort[port].pins & ~onPins[port]);
+
+        GPIO_PRT_DR_SET(ledPort[port].port) = highPins;
+        GPIO_PRT_DR_CLR(ledPort[port].port) = ledPort[port].pins & ~highPins;
     }
 }
 
@@ -49,6 +49,7 @@
 /*******************************************************************************
 * Function Prototypes
 *******************************************************************************/
+void led_control_init(void);
 void led_control(void);
 
 
@@ -43,7 +43,12 @@
 /*******************************************************************************
  * Include header files
  ******************************************************************************/
+#include "capsense_frame.h"
 #include "capsense_fss_algorithm.h"
+#include "capsense_fss_tuner.h"
+#include "capsense_idle.h"
+#include "capsense_profile.h"
+#include "capsense_status_map.h"
 #include "led_control.h"
 #include "cy_pdl.h"
 #include "cybsp.h"
@@ -64,6 +69,22 @@
 *******************************************************************************/
 cy_stc_scb_ezi2c_context_t ezi2c_context;
 
+#if (CAPSENSE_IDLE_ENABLE != 0u)
+/* Holds off Deep Sleep while an I2C transaction is in progress */
+static cy_stc_syspm_callback_params_t ezi2c_deep_sleep_params =
+{
+    .base = CYBSP_EZI2C_HW,
+    .context = &ezi2c_context
+};
+
+static cy_stc_syspm_callback_t ezi2c_deep_sleep_cb =
+{
+    .callback = Cy_SCB_EZI2C_DeepSleepCallback,
+    .type = CY_SYSPM_DEEPSLEEP,
+    .callbackParams = &ezi2c_deep_sleep_params
+};
+#endif
+
 /*******************************************************************************
 * Function Prototypes
 *******************************************************************************/
@@ -80,9 +101,9 @@ static void initialize_capsense_tuner(void);
 *       1. Initial setup of device
 *       2. Initialize tuner communication
 *       3. Initialize CapSense
-*       4. Apply FSS algorithm
-*       5. Change the status of LEDs to visually indicate the button status
-*       6. Scan touch input continuously
+*       4. Scan touch input continuously, sleeping while a frame is scanned
+*       5. Apply FSS algorithm while the next frame is scanned
+*       6. Change the status of LEDs to visually indicate the button status
 *
 * Return:
 *  int
@@ -110,27 +131,24 @@ int main(void)
     /* Initialize CapSense */
     initialize_capsense();
 
+    /* Group the LEDs by GPIO port */
+    led_control_init();
+
     /* Start the first scan */
-    Cy_CapSense_ScanAllWidgets(&cy_capsense_context);
+    capsense_frame_start();
 
     for (;;)
     {
-        if(CY_CAPSENSE_NOT_BUSY == Cy_CapSense_IsBusy(&cy_capsense_context))
-        {
-            /* Process all widgets */
-            Cy_CapSense_ProcessAllWidgets(&cy_capsense_context);
-
-            /* Apply FSS algorithm */
-            capsense_fss();
+        /* Sleep until the scan is complete */
+        capsense_frame_wait();
 
+        /* Process the scan, start the next one and apply FSS algorithm */
+        if (capsense_frame_process())
+        {
             /* Turning LEDs ON/OFF based on button status */
+            uint32_t start = capsense_profile_start();
             led_control();
-
-            /* Establishes synchronized communication with the CapSense Tuner tool */
-            Cy_CapSense_RunTuner(&cy_capsense_context);
-
-            /* Start the next scan */
-            Cy_CapSense_ScanAllWidgets(&cy_capsense_context);
+            capsense_profile_stop(CAPSENSE_PROFILE_LED, start);
         }
     }
 }
@@ -169,6 +187,15 @@ static void initialize_capsense(void)
         status = Cy_CapSense_Enable(&cy_capsense_context);
     }
 
+    /* Build the FSS sensor table from the now fixed widget layout */
+    capsense_fss_init();
+
+    /* Publish the FSS configuration to the FSS control block */
+    capsense_fss_tuner_init();
+
+    /* Wake the main loop at the end of every frame scan */
+    capsense_frame_init();
+
     if(status != CYRET_SUCCESS)
     {
         /* This status could fail before tuning the sensors correctly.
@@ -196,7 +223,8 @@ static void capsense_isr(void)
 * Function Name: initialize_capsense_tuner
 ********************************************************************************
 * Summary:
-*  EZI2C module to communicate with the CapSense Tuner tool.
+*  EZI2C module to communicate with the CapSense Tuner tool, or to expose the
+*  button status map with CAPSENSE_STATUS_MAP_ENABLE.
 *
 *******************************************************************************/
 static void initialize_capsense_tuner(void)
@@ -216,6 +244,14 @@ static void initialize_capsense_tuner(void)
     Cy_SysInt_Init(&ezi2c_intr_config, ezi2c_isr);
     NVIC_EnableIRQ(ezi2c_intr_config.intrSrc);
 
+#if (CAPSENSE_STATUS_MAP_ENABLE != 0u)
+    /* Set the read-only button status map as the I2C buffer on the primary
+     * slave address, for a host that polls the buttons in production.
+     */
+    Cy_SCB_EZI2C_SetBuffer1(CYBSP_EZI2C_HW, (uint8 *)&capsense_status_map,
+                            sizeof(capsense_status_map), 0u,
+                            &ezi2c_context);
+#else
     /* Set the CapSense data structure as the I2C buffer to be exposed to the
      * master on primary slave address interface. Any I2C host tools such as
      * the Tuner or the Bridge Control Panel can read this buffer but you can
@@ -224,6 +260,20 @@ static void initialize_capsense_tuner(void)
     Cy_SCB_EZI2C_SetBuffer1(CYBSP_EZI2C_HW, (uint8 *)&cy_capsense_tuner,
                             sizeof(cy_capsense_tuner), sizeof(cy_capsense_tuner),
                             &ezi2c_context);
+#endif
+
+    /* Set the FSS control block as the I2C buffer on the secondary slave
+     * address. The host writes the FSS settings below FSS_TUNER_RW_BOUNDARY
+     * and reads back the status before and after FSS.
+     */
+    Cy_SCB_EZI2C_SetBuffer2(CYBSP_EZI2C_HW, (uint8 *)&capsense_fss_tuner,
+                            sizeof(capsense_fss_tuner), FSS_TUNER_RW_BOUNDARY,
+                            &ezi2c_context);
+
+#if (CAPSENSE_IDLE_ENABLE != 0u)
+    /* The EZI2C slave address match wakes the device from Deep Sleep */
+    (void)Cy_SysPm_RegisterCallback(&ezi2c_deep_sleep_cb);
+#endif
 
     /* Enables the SCB block for the EZI2C operation. */
     Cy_SCB_EZI2C_Enable(CYBSP_EZI2C_HW);
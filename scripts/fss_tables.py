@@ -0,0 +1,308 @@
+#!/usr/bin/env python3
+################################################################################
+# \file fss_tables.py
+# \version 1.0
+#
+# \brief
+# Generates cycfg_fss.h, the FSS tables of a target, from its CAPSENSE design
+# (design.cycapsense), its pin aliases (design.modus) and its FSS annotations
+# (design.fss.json). Run by the PREBUILD step of the application Makefile.
+#
+#   fss_tables.py <design.cycapsense> <design.modus> <design.fss.json> <output>
+#
+# The header defines the button sensor table, FSS_SENSOR_COUNT,
+# FSS_ENABLE_MASK, FSS_GROUP_TABLE, FSS_NEIGHBOUR_TABLE and the LED tables as
+# constant initializers, and checks them against the CAPSENSE configuration
+# generated from the same design, so that the build fails if the two differ.
+#
+# The annotation file names every button sensor of the design as
+# "<widget>.Sns<n>", n counting the sensors of the widget from 0:
+#
+#   {
+#       "sensors": {
+#           "Button0.Sns0": { "group": "keys", "led": "CYBSP_LED_BTN2" },
+#           "Button0.Sns1": { "group": "keys", "neighbours": [ "Button0.Sns0" ] },
+#           "Button1.Sns0": { "fss": false }
+#       }
+#   }
+#
+# "fss" (default true) applies FSS to the button. "group" names its FSS
+# group; the buttons of a group must be consecutive, and without any group,
+# all buttons form one. "neighbours" lists its physical neighbours, which
+# loads a neighbour table instead of the groups; they are made mutual.
+# "led" is the pin alias of the LED that shows the button status.
+#
+################################################################################
+# \copyright
+# Copyright 2022 Cypress Semiconductor Corporation
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+################################################################################
+
+import json
+import os
+import re
+import sys
+import xml.etree.ElementTree as ElementTree
+
+# Button widget types, the only widgets FSS works on
+BUTTON_TYPES = ("CSD_BUTTON", "CSX_BUTTON")
+
+WORD_BITS = 32
+
+LOCATION_PATTERN = re.compile(r"ioss\[0\]\.port\[(\d+)\]\.pin\[(\d+)\]$")
+
+
+class TableError(Exception):
+    pass
+
+
+def elements(path, name):
+    """Returns the elements of an XML file with the given name, in document
+    order, whatever their namespace."""
+    return [element for element in ElementTree.parse(path).getroot().iter()
+            if element.tag.rsplit("}", 1)[-1] == name]
+
+
+def read_sensors(path):
+    """Returns the widgets of the design in widget order, as (name, type,
+    sensor count), and the total number of sensors."""
+    widgets = []
+    for widget in elements(path, "Widget"):
+        electrodes = widget.findall("Electrodes/Electrode")
+        if widget.get("type").startswith("CSX_"):
+            # CSX: one sensor per crossing of a column (Rx) and a row (Tx)
+            columns = sum(1 for e in electrodes if e.get("kind") == "Column")
+            rows = sum(1 for e in electrodes if e.get("kind") == "Row")
+            count = columns * rows
+        else:
+            count = len(electrodes)
+        widgets.append((widget.get("id"), widget.get("type"), count))
+
+    return widgets, sum(count for _, _, count in widgets)
+
+
+def read_pins(path):
+    """Returns the port and pin of every pin alias of the design."""
+    pins = {}
+    for block in elements(path, "Block"):
+        match = LOCATION_PATTERN.match(block.get("location", ""))
+        if match:
+            for alias in block:
+                if alias.tag.rsplit("}", 1)[-1] == "Alias":
+                    pins[alias.get("value")] = (int(match.group(1)), int(match.group(2)))
+    return pins
+
+
+def macro_name(widget):
+    return re.sub(r"[^A-Za-z0-9]", "_", widget).upper()
+
+
+def words(bits, count):
+    """Formats a set of bit indices as the words of an fss_bitmap_t."""
+    values = [0] * ((count + WORD_BITS - 1) // WORD_BITS)
+    for bit in bits:
+        values[bit // WORD_BITS] |= 1 << (bit % WORD_BITS)
+    return ", ".join("0x%08Xu" % value for value in values)
+
+
+def build(design, modus, annotations):
+    widgets, total_sensors = read_sensors(design)
+    pins = read_pins(modus)
+    with open(annotations) as file:
+        annotated = json.load(file).get("sensors", {})
+
+    # Button sensors in widget order: their index is their FSS bit. The
+    # sensor contexts of all widgets are one array in widget order, and the
+    # CY_CAPSENSE_<widget>_SNS<n>_ID macros count the sensors of each widget
+    # from 0, so a sensor is at the sensor count of the widgets before it + n.
+    buttons = []
+    checks = []
+    first_sensor = 0
+    for widget_id, (name, kind, count) in enumerate(widgets):
+        checks.append(("CY_CAPSENSE_%s_WDGT_ID" % macro_name(name), widget_id))
+        if kind in BUTTON_TYPES:
+            for sensor in range(count):
+                buttons.append(("%s.Sns%d" % (name, sensor), first_sensor + sensor))
+        first_sensor += count
+    names = [button for button, _ in buttons]
+    bit_of = {button: bit for bit, button in enumerate(names)}
+
+    if not buttons:
+        raise TableError("%s: no button widget" % design)
+    for button in annotated:
+        if button not in bit_of:
+            raise TableError("%s: %s is not a button sensor of the design" % (annotations, button))
+    for button in names:
+        if button not in annotated:
+            raise TableError("%s: button sensor %s of the design is not annotated" % (annotations, button))
+
+    enabled = [bit for bit, button in enumerate(names) if annotated[button].get("fss", True)]
+
+    # Groups: runs of consecutive buttons with the same group name
+    groups = []
+    group_names = [annotated[button].get("group") for button in names]
+    if any(group_names):
+        seen = set()
+        for bit, group in enumerate(group_names):
+            if group is None:
+                continue
+            if groups and group_names[bit - 1] == group:
+                groups[-1][1] += 1
+            elif group in seen:
+                raise TableError("%s: the buttons of group %s are not consecutive" % (annotations, group))
+            else:
+                seen.add(group)
+                groups.append([bit, 1])
+    else:
+        groups.append([0, len(names)])
+
+    # Neighbours, made mutual
+    neighbours = [set() for _ in names]
+    for bit, button in enumerate(names):
+        for other in annotated[button].get("neighbours", []):
+            if other not in bit_of or other == button:
+                raise TableError("%s: invalid neighbour %s of %s" % (annotations, other, button))
+            neighbours[bit].add(bit_of[other])
+            neighbours[bit_of[other]].add(bit)
+
+    # LEDs, grouped by port
+    leds = []
+    ports = []
+    for bit, button in enumerate(names):
+        alias = annotated[button].get("led")
+        if alias is None:
+            continue
+        if alias not in pins:
+            raise TableError("%s: pin alias %s of %s is not in %s" % (annotations, alias, button, modus))
+        port, pin = pins[alias]
+        port_index = next((index for index, entry in enumerate(ports) if entry[0] == port), None)
+        if port_index is None:
+            port_index = len(ports)
+            ports.append([port, alias, 0])
+        ports[port_index][2] |= 1 << pin
+        leds.append((bit, alias, pin, port_index))
+
+    return {
+        "buttons": buttons,
+        "checks": checks,
+        "total_sensors": total_sensors,
+        "enabled": enabled,
+        "groups": groups,
+        "neighbours": neighbours if any(neighbours) else None,
+        "leds": leds,
+        "ports": ports,
+    }
+
+
+def render(tables, sources):
+    count = len(tables["buttons"])
+    lines = []
+    add = lines.append
+
+    add("/*******************************************************************************")
+    add("* File Name: cycfg_fss.h")
+    add("*")
+    add("* Description: FSS tables generated by scripts/fss_tables.py from")
+    for source in sources:
+        add("*              %s" % source)
+    add("*              Do not edit: change the design or the annotations instead.")
+    add("*")
+    add("*******************************************************************************/")
+    add("")
+    add("#ifndef CYCFG_FSS_H")
+    add("#define CYCFG_FSS_H")
+    add("")
+    add("#include \"cycfg_capsense.h\"")
+    if tables["leds"]:
+        add("#include \"cycfg_pins.h\"")
+    add("")
+    add("/* The CAPSENSE configuration must come from the same design */")
+    add("#if (CY_CAPSENSE_SENSOR_COUNT != %du)" % tables["total_sensors"])
+    add("#error \"The FSS tables do not match the CAPSENSE configuration: regenerate them\"")
+    add("#endif")
+    for macro, value in tables["checks"]:
+        add("#if !defined(%s) || (%s != %du)" % (macro, macro, value))
+        add("#error \"The FSS tables do not match the CAPSENSE widgets: regenerate them\"")
+        add("#endif")
+    add("")
+    add("/* Button sensors in FSS bit order */")
+    add("#define FSS_SENSOR_COUNT               (%du)" % count)
+    add("#define FSS_BUTTON_SENSOR_TABLE        \\")
+    for bit, (name, index) in enumerate(tables["buttons"]):
+        add("    &cy_capsense_tuner.sensorContext[%du]%s /* %d: %s */" %
+            (index, "," if bit + 1 < count else " ", bit, name) +
+            (" \\" if bit + 1 < count else ""))
+    add("")
+    add("#define FSS_ENABLE_MASK                %s" % words(tables["enabled"], count))
+    add("#define FSS_GROUP_TABLE                %s" %
+        ", ".join("{ %du, %du }" % (first, size) for first, size in tables["groups"]))
+    if tables["neighbours"] is not None:
+        add("#define FSS_NEIGHBOUR_TABLE            \\")
+        for bit, bits in enumerate(tables["neighbours"]):
+            add("    { { %s } }%s" % (words(sorted(bits), count), ", \\" if bit + 1 < count else ""))
+    if tables["leds"]:
+        add("")
+        add("/* LEDs: { button bit, port, pin }, the LED pins of each port, and the")
+        add(" * index of the port of each LED")
+        add(" */")
+        add("#define FSS_LED_MAP_TABLE              \\")
+        for index, (bit, alias, pin, _) in enumerate(tables["leds"]):
+            add("    { %du, %s_PORT, %s_NUM }%s" % (bit, alias, alias, ", \\" if index + 1 < len(tables["leds"]) else ""))
+        add("#define FSS_LED_PORT_TABLE             %s" %
+            ", ".join("{ %s_PORT, 0x%08Xu }" % (alias, mask) for _, alias, mask in tables["ports"]))
+        add("#define FSS_LED_PORT_INDEX_TABLE       %s" %
+            ", ".join("%du" % port_index for _, _, _, port_index in tables["leds"]))
+        for _, alias, pin, _ in tables["leds"]:
+            add("#if (%s_NUM != %du)" % (alias, pin))
+            add("#error \"The FSS LED tables do not match the pin configuration: regenerate them\"")
+            add("#endif")
+    add("")
+    add("#endif /* CYCFG_FSS_H */")
+    add("")
+    add("")
+    add("/* [] END OF FILE */")
+    return "\n".join(lines) + "\n"
+
+
+def main(argv):
+    if len(argv) != 5:
+        sys.stderr.write("usage: %s <design.cycapsense> <design.modus> <design.fss.json> <output>\n" % argv[0])
+        return 1
+
+    design, modus, annotations, output = argv[1:]
+    try:
+        tables = build(design, modus, annotations)
+    except (TableError, OSError, ValueError, ElementTree.ParseError) as error:
+        sys.stderr.write("fss_tables: %s\n" % error)
+        return 1
+
+    text = render(tables, [os.path.basename(path) for path in (design, modus, annotations)])
+
+    # Leaving an unchanged header alone, so that nothing is rebuilt
+    try:
+        with open(output) as file:
+            if file.read() == text:
+                return 0
+    except OSError:
+        pass
+
+    os.makedirs(os.path.dirname(output) or ".", exist_ok=True)
+    with open(output, "w") as file:
+        file.write(text)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))